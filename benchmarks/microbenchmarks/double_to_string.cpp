@@ -7,6 +7,7 @@
 #include <locale>
 #include <random>
 #include <sstream>
+#include <xlnt/utils/numeric.hpp>
 
 namespace {
 
@@ -176,6 +177,19 @@ BENCHMARK_F(RandFloats, string_from_double_snprintf_fixed)
     }
 }
 
+// what xlsx_producer.cpp uses, format_double with snprintf as a fallback
+BENCHMARK_F(RandFloats, string_from_double_xlnt_serialiser)
+(benchmark::State &state)
+{
+    xlnt::detail::number_serialiser ser;
+    char buf[xlnt::detail::number_serialiser::max_serialised_size];
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(
+            ser.serialise(get_rand(), buf));
+    }
+}
+
 // locale names are different between OS's, and std::from_chars is only complete in MSVC
 #ifdef _MSC_VER
 
@@ -7,6 +7,7 @@
 #include <locale>
 #include <random>
 #include <sstream>
+#include <xlnt/utils/numeric.hpp>
 
 namespace {
 
@@ -180,6 +181,19 @@ BENCHMARK_F(RandFloatStrs, double_from_string_strtod_fixed_const_ref)
     }
 }
 
+// what xlsx_consumer.cpp uses, parse_double with strtod as a fallback
+BENCHMARK_F(RandFloatStrs, double_from_string_number_serialiser)
+(benchmark::State &state)
+{
+    xlnt::detail::number_serialiser converter;
+    while (state.KeepRunning())
+    {
+        const std::string &input = get_rand();
+        benchmark::DoNotOptimize(
+            converter.deserialise(input.data(), input.size()));
+    }
+}
+
 // locale names are different between OS's, and std::from_chars is only complete in MSVC
 #ifdef _MSC_VER
 
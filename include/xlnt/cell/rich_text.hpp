@@ -158,22 +158,22 @@ private:
     std::vector<rich_text_run> runs_;
     std::vector<phonetic_run> phonetic_runs_;
     optional<phonetic_pr> phonetic_properties_;
+
+    /// <summary>
+    /// Most text is a single run without a font. Such text is kept here instead
+    /// of in runs_, which is then empty, so that it costs no more than the string.
+    /// </summary>
+    std::string plain_text_;
+    bool plain_preserve_space_ = false;
+    bool is_plain_ = false;
+
+    friend class rich_text_hash;
 };
 
 class XLNT_API rich_text_hash
 {
 public:
-    std::size_t operator()(const rich_text &k) const
-    {
-        std::size_t res = 0;
-
-        for (auto r : k.runs())
-        {
-            res ^= std::hash<std::string>()(r.first);
-        }
-
-        return res;
-    }
+    std::size_t operator()(const rich_text &k) const;
 };
 
 } // namespace xlnt
@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdio>
 #include <limits>
 #include <sstream>
 #include <type_traits>
@@ -102,6 +104,24 @@ bool float_equals(const LNumber &lhs, const RNumber &rhs,
     return ((lhs + scaled_fuzz) >= rhs) && ((rhs + scaled_fuzz) >= lhs);
 }
 
+/// <summary>
+/// Converts the decimal number in [first, last), written as SpreadsheetML
+/// writes numbers (an optional sign, digits with an optional fraction and an
+/// optional exponent), to the nearest double regardless of the global locale.
+/// Returns false, leaving result alone, if the range holds anything else or,
+/// very rarely, if the fast algorithm can't decide the rounding.
+/// </summary>
+XLNT_API bool parse_double(const char *first, const char *last, double &result);
+
+/// <summary>
+/// Writes value to buffer as snprintf's "%.15g" would in the C locale, i.e.
+/// rounded to Excel's 15 significant digits without trailing zeros, and sets
+/// size to the number of characters written. buffer must have room for at
+/// least 24 characters. Returns false, writing nothing useful, for infinities,
+/// NaN and the few values whose rounding needs more precision than this has.
+/// </summary>
+XLNT_API bool format_double(double value, char *buffer, std::size_t &size);
+
 class number_serialiser
 {
     static constexpr int Excel_Digit_Precision = 15; //sf
@@ -133,20 +153,54 @@ public:
     {
     }
 
-    std::string serialise(double d) const
+    /// <summary>
+    /// The most characters serialise(double, char *) writes.
+    /// </summary>
+    static constexpr std::size_t max_serialised_size = 32;
+
+    /// <summary>
+    /// Writes d to buffer, which must have room for max_serialised_size
+    /// characters, and returns the number of characters written.
+    /// </summary>
+    std::size_t serialise(double d, char *buffer) const
     {
-        char buf[30];
-        int len = snprintf(buf, sizeof(buf), "%.15g", d);
+        std::size_t size;
+        if (format_double(d, buffer, size))
+        {
+            return size;
+        }
+        // infinities, NaN and near ties are left to snprintf
+        int len = snprintf(buffer, max_serialised_size, "%.15g", d);
         if (should_convert_comma)
         {
-            convert_comma_to_pt(buf, len);
+            convert_comma_to_pt(buffer, len);
         }
-        return std::string(buf, static_cast<size_t>(len));
+        return static_cast<size_t>(len);
+    }
+
+    /// <summary>
+    /// Replaces the contents of out with d, reusing its storage.
+    /// </summary>
+    void serialise(double d, std::string &out) const
+    {
+        char buf[max_serialised_size];
+        out.assign(buf, serialise(d, buf));
+    }
+
+    std::string serialise(double d) const
+    {
+        char buf[max_serialised_size];
+        return std::string(buf, serialise(d, buf));
     }
 
     double deserialise(std::string &s) const noexcept
     {
         assert(!s.empty());
+        double result;
+        if (parse_double(s.data(), s.data() + s.size(), result))
+        {
+            return result;
+        }
         if (should_convert_comma)
         {
             // s.data() doesn't have a non-const overload until c++17, hence this little dance
@@ -158,6 +212,11 @@ public:
     double deserialise(const std::string &s) const
     {
         assert(!s.empty());
+        double result;
+        if (parse_double(s.data(), s.data() + s.size(), result))
+        {
+            return result;
+        }
         if (!should_convert_comma)
         {
             return strtod(s.c_str(), nullptr);
@@ -168,6 +227,29 @@ public:
         convert_pt_to_comma(buf, static_cast<size_t>(copy_end - buf));
         return strtod(buf, nullptr);
     }
+
+    double deserialise(const char *data, std::size_t size) const
+    {
+        assert(size > 0);
+        double result;
+        if (parse_double(data, data + size, result))
+        {
+            return result;
+        }
+        // anything else is left to strtod
+        char buf[64];
+        if (size >= sizeof(buf))
+        {
+            return deserialise(std::string(data, size));
+        }
+        std::copy(data, data + size, buf);
+        buf[size] = '\0';
+        if (should_convert_comma)
+        {
+            convert_pt_to_comma(buf, size);
+        }
+        return strtod(buf, nullptr);
+    }
 };
 
 } // namespace detail
@@ -0,0 +1,155 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <xlnt/xlnt_config.hpp>
+#include <xlnt/cell/index_types.hpp>
+#include <xlnt/utils/optional.hpp>
+
+namespace xlnt {
+
+/// <summary>
+/// Options controlling how workbook::load reads a file.
+/// </summary>
+class XLNT_API load_options
+{
+public:
+    /// <summary>
+    /// The number of threads used to parse worksheets. Each worksheet is an independent
+    /// part of the package, so several can be parsed at once and are then added to the
+    /// workbook in their original order. Shared strings and styles are always read first.
+    /// The default of 1 parses worksheets one after another on the calling thread and
+    /// 0 uses one thread per hardware core. Each of these threads may start another,
+    /// see pipeline_worksheets.
+    /// </summary>
+    std::size_t worksheet_threads = 1;
+
+    /// <summary>
+    /// If true, the cells of a worksheet too large to be scanned in one go are
+    /// decompressed and scanned on a second thread while the thread reading the
+    /// worksheet builds them. If false, no threads other than those given by
+    /// worksheet_threads are started, so that worksheet_threads = 1 reads everything
+    /// on the calling thread.
+    /// </summary>
+    bool pipeline_worksheets = true;
+
+    /// <summary>
+    /// The titles of the worksheets to read. Together with sheet_indices this selects
+    /// the worksheets that are loaded; the others are left out of the workbook entirely,
+    /// as if they had been removed after loading. When both are empty, every worksheet
+    /// is read. Naming a worksheet the file doesn't contain throws key_not_found.
+    /// </summary>
+    std::vector<std::string> sheet_titles;
+
+    /// <summary>
+    /// The zero-based positions, in the file's order, of the worksheets to read.
+    /// See sheet_titles.
+    /// </summary>
+    std::vector<std::size_t> sheet_indices;
+
+    /// <summary>
+    /// If true, the stylesheet and theme aren't read and cells, rows and columns
+    /// are loaded without formats. The workbook is given the stylesheet of a new
+    /// workbook so that it can still be formatted and saved.
+    /// </summary>
+    bool skip_styles = false;
+
+    /// <summary>
+    /// If true, cell comments and their VML shapes aren't read and are left out
+    /// of the workbook.
+    /// </summary>
+    bool skip_comments = false;
+
+    /// <summary>
+    /// If true, drawings and the images they embed aren't read and are left out
+    /// of the workbook.
+    /// </summary>
+    bool skip_drawings = false;
+
+    /// <summary>
+    /// If true, cell formulas are dropped and only their last calculated values are kept.
+    /// </summary>
+    bool skip_formulas = false;
+
+    /// <summary>
+    /// The first row of the window of cells to read from each worksheet, 1 if not set.
+    /// Rows, cells, comments and hyperlinks outside of the window are left out, though
+    /// cells inside it keep shared formulas whose text is held by a cell outside it.
+    /// </summary>
+    optional<row_t> first_row;
+
+    /// <summary>
+    /// The last row of the window of cells to read, unbounded if not set. Reading a
+    /// worksheet stops at the first row past this one, so the rest of the part isn't
+    /// even decompressed, at the cost of whatever follows the cells in it such as
+    /// merged cells, hyperlinks and page setup, which are then left out too.
+    /// </summary>
+    optional<row_t> last_row;
+
+    /// <summary>
+    /// The first column of the window of cells to read, A if not set.
+    /// </summary>
+    optional<column_t> first_column;
+
+    /// <summary>
+    /// The last column of the window of cells to read, unbounded if not set.
+    /// </summary>
+    optional<column_t> last_column;
+
+    /// <summary>
+    /// If true, only the workbook itself, shared strings and styles are read by load.
+    /// Each worksheet is read the first time it is asked for, by title, index or id
+    /// or by iterating over the workbook, from a copy of the file kept in memory until
+    /// then. sheet_titles() and sheet_count() don't read any worksheets. If reading a
+    /// worksheet fails, the exception is thrown by the call that asked for it and the
+    /// worksheet is read again on the next one. Since const member functions of the
+    /// workbook may read worksheets too, a lazily loaded workbook mustn't be used from
+    /// several threads at once, even through const references, until every worksheet
+    /// has been read.
+    /// </summary>
+    bool lazy_worksheets = false;
+};
+
+inline bool operator==(const load_options &lhs, const load_options &rhs)
+{
+    return lhs.worksheet_threads == rhs.worksheet_threads
+        && lhs.pipeline_worksheets == rhs.pipeline_worksheets
+        && lhs.sheet_titles == rhs.sheet_titles
+        && lhs.sheet_indices == rhs.sheet_indices
+        && lhs.skip_styles == rhs.skip_styles
+        && lhs.skip_comments == rhs.skip_comments
+        && lhs.skip_drawings == rhs.skip_drawings
+        && lhs.skip_formulas == rhs.skip_formulas
+        && lhs.first_row == rhs.first_row
+        && lhs.last_row == rhs.last_row
+        && lhs.first_column == rhs.first_column
+        && lhs.last_column == rhs.last_column
+        && lhs.lazy_worksheets == rhs.lazy_worksheets;
+}
+
+} // namespace xlnt
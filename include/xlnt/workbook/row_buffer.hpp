@@ -0,0 +1,129 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <xlnt/xlnt_config.hpp>
+#include <xlnt/cell/cell_type.hpp>
+#include <xlnt/cell/index_types.hpp>
+#include <xlnt/utils/optional.hpp>
+
+namespace xlnt {
+
+/// <summary>
+/// Caller-owned storage for the cells read by streaming_workbook_reader::read_row
+/// and read_rows. Each cell is an entry in every one of the vectors below, in the
+/// order the cells appear in the worksheet. Filling a buffer keeps the storage of
+/// its previous contents, so once it has grown to fit a batch, reading more
+/// batches of that size doesn't allocate. Formulas aren't kept, only their cached
+/// values.
+/// </summary>
+class XLNT_API row_buffer
+{
+public:
+    /// <summary>
+    /// Removes every cell but keeps the allocated storage.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Returns the number of cells in the buffer.
+    /// </summary>
+    std::size_t size() const;
+
+    /// <summary>
+    /// Returns true if the buffer holds no cells.
+    /// </summary>
+    bool empty() const;
+
+    /// <summary>
+    /// Returns the first character of the text of the cell at position index.
+    /// The text isn't null-terminated, see text_sizes.
+    /// </summary>
+    const char *text_data(std::size_t index) const;
+
+    /// <summary>
+    /// Returns a copy of the text of the cell at position index.
+    /// </summary>
+    std::string text(std::size_t index) const;
+
+    /// <summary>
+    /// The row of each cell.
+    /// </summary>
+    std::vector<row_t> rows;
+
+    /// <summary>
+    /// The column of each cell.
+    /// </summary>
+    std::vector<column_t::index_t> columns;
+
+    /// <summary>
+    /// The type of each cell's value. A cell without a value is empty.
+    /// </summary>
+    std::vector<cell_type> types;
+
+    /// <summary>
+    /// The value of number and date cells, 1 or 0 for boolean cells and 0 otherwise.
+    /// </summary>
+    std::vector<double> numbers;
+
+    /// <summary>
+    /// The position in workbook::shared_strings() of the text of shared string
+    /// cells and 0 for other cells.
+    /// </summary>
+    std::vector<std::size_t> shared_strings;
+
+    /// <summary>
+    /// The id of each cell's format, as passed to workbook::format, if it has one.
+    /// </summary>
+    std::vector<optional<std::size_t>> formats;
+
+    /// <summary>
+    /// The position in characters of the text of inline string, formula string
+    /// and error cells. Other cells have no text.
+    /// </summary>
+    std::vector<std::size_t> text_offsets;
+
+    /// <summary>
+    /// The length of the text of each cell.
+    /// </summary>
+    std::vector<std::size_t> text_sizes;
+
+    /// <summary>
+    /// The text of all cells, one after another.
+    /// </summary>
+    std::string characters;
+
+    /// <summary>
+    /// The number of the last row read into the buffer or 0 if none has been.
+    /// After read_row() this is the row that was read, even if it has no cells.
+    /// </summary>
+    row_t last_row = 0;
+};
+
+} // namespace xlnt
@@ -41,10 +41,12 @@ class cell;
 template <typename T>
 class optional;
 class path;
+class row_buffer;
 class workbook;
 class worksheet;
 
 namespace detail {
+class sheet_data_splitter;
 class xlsx_consumer;
 }
 
@@ -71,6 +73,22 @@ public:
     /// </summary>
     cell read_cell();
 
+    /// <summary>
+    /// Replaces the contents of row with the cells of the next row in the current
+    /// worksheet, or those that are left of it after read_cell(), and returns true,
+    /// or returns false, leaving row empty, if the last row has already been read.
+    /// A row without cells is read as an empty buffer, whose last_row tells which
+    /// row it was. A row that read_cell() has read all of is skipped.
+    /// </summary>
+    bool read_row(row_buffer &row);
+
+    /// <summary>
+    /// Replaces the contents of batch with the cells of up to count more rows in the
+    /// current worksheet and returns the number of rows read, which is less than
+    /// count only once the last row has been read.
+    /// </summary>
+    std::size_t read_rows(std::size_t count, row_buffer &batch);
+
     bool has_worksheet(const std::string &name);
 
     /// <summary>
@@ -129,14 +147,21 @@ public:
     /// </summary>
     std::vector<std::string> sheet_titles();
 
+    /// <summary>
+    /// Returns the workbook being read. Its shared strings and formats are those
+    /// that the cells read by read_row() and read_rows() refer to by index.
+    /// </summary>
+    const xlnt::workbook &workbook() const;
+
 private:
     std::string worksheet_rel_id_;
     std::unique_ptr<detail::xlsx_consumer> consumer_;
-    std::unique_ptr<workbook> workbook_;
+    std::unique_ptr<xlnt::workbook> workbook_;
     std::unique_ptr<std::istream> stream_;
     std::unique_ptr<std::streambuf> stream_buffer_;
     std::unique_ptr<std::istream> part_stream_;
     std::unique_ptr<std::streambuf> part_stream_buffer_;
+    std::unique_ptr<detail::sheet_data_splitter> sheet_data_;
     std::unique_ptr<xml::parser> parser_;
 };
 
@@ -25,6 +25,7 @@
 
 #include <cstddef>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,14 +39,26 @@ namespace xlnt {
 
 class cell;
 class cell_reference;
+class format;
+class path;
+class workbook;
 class worksheet;
+struct date;
+struct datetime;
+struct time;
+struct timedelta;
 
 namespace detail {
 class xlsx_producer;
 } // namespace detail
 
 /// <summary>
-/// workbook is the container for all other parts of the document.
+/// Writes a workbook to an XLSX file a cell at a time. Each worksheet part is
+/// compressed into the archive as its rows arrive and the other parts are
+/// written by close(), so memory use doesn't depend on the number of rows.
+/// Cells must be written in order, left to right and top to bottom. Formats
+/// are kept in the workbook returned by workbook(), whose worksheets never hold
+/// any cells. Comments and hyperlinks of written cells aren't saved.
 /// </summary>
 class XLNT_API streaming_workbook_writer
 {
@@ -56,23 +69,62 @@ public:
     /// <summary>
     /// Finishes writing of the remaining contents of the workbook and closes
     /// currently open write stream. This will be called automatically by the
-    /// destructor if it hasn't already been called manually.
+    /// destructor if it hasn't already been called manually, but the destructor
+    /// swallows any exception, so call this to find out whether writing succeeded.
+    /// The writer is closed afterwards even if this throws.
     /// </summary>
     void close();
 
     /// <summary>
-    /// Writes a cell to the currently active worksheet at the position given by
-    /// ref and with the given value. ref should be to the right of or below
-    /// the previously written cell.
+    /// Returns a cell of the current worksheet at the position given by ref to
+    /// be given a value and format. It is written when the next cell or row is
+    /// added, after which changing it has no effect. ref must be to the right
+    /// of or below the previously written cell. Strings given to the cell are
+    /// kept in the shared string table in memory until close() unless
+    /// spill_shared_strings() has been called.
     /// </summary>
     cell add_cell(const cell_reference &ref);
 
+    /// <summary>
+    /// Writes a row below the last one written to, putting values in consecutive
+    /// columns starting at A. A value can be anything cell::value accepts other
+    /// than rich text and cells, or nullptr to leave a column empty. Strings are
+    /// written inline rather than to the shared string table, so nothing is kept
+    /// once the row is written, unless spill_shared_strings() has been called.
+    /// A format among the values isn't written itself but is applied to the
+    /// values that follow it in the row.
+    /// </summary>
+    template <typename... Values>
+    void append_row(const Values &... values)
+    {
+        begin_row();
+        // calls append_value for each value in order
+        const int expansion[] = {0, (append_value(values), 0)...};
+        (void)expansion;
+    }
+
+    /// <summary>
+    /// Makes append_row and add_cell put strings in the shared string table,
+    /// each distinct string once, with the table kept in a temporary file until
+    /// close() writes it, so that memory use doesn't grow with the strings.
+    /// Strings with formatted runs are written inline instead. This must be
+    /// called before any string is written.
+    /// </summary>
+    void spill_shared_strings();
+
     /// <summary>
     /// Ends writing of data to the current sheet and begins writing a new sheet
-    /// with the given title.
+    /// with the given title. Cells added before the first call go to the
+    /// workbook's first sheet, which is renamed to title if it is still empty.
     /// </summary>
     worksheet add_worksheet(const std::string &title);
 
+    /// <summary>
+    /// Returns the workbook being written, for creating formats to give to
+    /// cells and for setting properties. Its worksheets never hold any cells.
+    /// </summary>
+    xlnt::workbook &workbook();
+
     /// <summary>
     /// Serializes the workbook into an XLSX file and saves the bytes into
     /// byte vector data.
@@ -105,12 +157,41 @@ public:
     void open(std::ostream &stream);
 
     std::unique_ptr<xlnt::detail::xlsx_producer> producer_;
-    std::unique_ptr<workbook> workbook_;
+    std::unique_ptr<xlnt::workbook> workbook_;
     std::unique_ptr<std::ostream> stream_;
     std::unique_ptr<std::streambuf> stream_buffer_;
     std::unique_ptr<std::ostream> part_stream_;
     std::unique_ptr<std::streambuf> part_stream_buffer_;
     std::unique_ptr<xml::serializer> serializer_;
+
+private:
+    /// <summary>
+    /// Moves to the row after the last one written to for append_row.
+    /// </summary>
+    void begin_row();
+
+    /// <summary>
+    /// Writes value to the next cell of the row begun by begin_row.
+    /// </summary>
+    void append_value(std::nullptr_t);
+    void append_value(bool value);
+    void append_value(int value);
+    void append_value(unsigned int value);
+    void append_value(long long int value);
+    void append_value(unsigned long long int value);
+    void append_value(float value);
+    void append_value(double value);
+    void append_value(const date &value);
+    void append_value(const time &value);
+    void append_value(const datetime &value);
+    void append_value(const timedelta &value);
+    void append_value(const std::string &value);
+    void append_value(const char *value);
+
+    /// <summary>
+    /// Applies value to the cells appended after it in the current row.
+    /// </summary>
+    void append_value(const format &value);
 };
 
 } // namespace xlnt
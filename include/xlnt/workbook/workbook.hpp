@@ -35,6 +35,7 @@
 
 #include <xlnt/xlnt_config.hpp>
 #include <xlnt/cell/rich_text.hpp>
+#include <xlnt/workbook/load_options.hpp>
 
 namespace xlnt {
 
@@ -141,6 +142,11 @@ public:
     /// </summary>
     workbook(const xlnt::path &file, const std::string &password);
 
+    /// <summary>
+    /// load the xlsx file at path, reading only what options selects
+    /// </summary>
+    workbook(const xlnt::path &file, const load_options &options);
+
     /// <summary>
     /// construct the workbook from any data stream where the data is the binary form of a workbook
     /// </summary>
@@ -151,6 +157,12 @@ public:
     /// </summary>
     workbook(std::istream &data, const std::string &password);
 
+    /// <summary>
+    /// construct the workbook from any data stream where the data is the binary form of a workbook,
+    /// reading only what options selects
+    /// </summary>
+    workbook(std::istream &data, const load_options &options);
+
     /// <summary>
     /// Move constructor. Constructs a workbook from existing workbook, other.
     /// </summary>
@@ -528,6 +540,12 @@ public:
     /// </summary>
     void load(const std::vector<std::uint8_t> &data, const std::string &password);
 
+    /// <summary>
+    /// Interprets byte vector data as an XLSX file and sets the content of this
+    /// workbook to match that file, reading it as described by options.
+    /// </summary>
+    void load(const std::vector<std::uint8_t> &data, const load_options &options);
+
     /// <summary>
     /// Interprets file with the given filename as an XLSX file and sets
     /// the content of this workbook to match that file.
@@ -540,6 +558,12 @@ public:
     /// </summary>
     void load(const std::string &filename, const std::string &password);
 
+    /// <summary>
+    /// Interprets file with the given filename as an XLSX file and sets the content
+    /// of this workbook to match that file, reading it as described by options.
+    /// </summary>
+    void load(const std::string &filename, const load_options &options);
+
 #ifdef _MSC_VER
     /// <summary>
     /// Interprets file with the given filename as an XLSX file and sets
@@ -552,6 +576,12 @@ public:
     /// given password and sets the content of this workbook to match that file.
     /// </summary>
     void load(const std::wstring &filename, const std::string &password);
+
+    /// <summary>
+    /// Interprets file with the given filename as an XLSX file and sets the content
+    /// of this workbook to match that file, reading it as described by options.
+    /// </summary>
+    void load(const std::wstring &filename, const load_options &options);
 #endif
 
     /// <summary>
@@ -566,6 +596,12 @@ public:
     /// </summary>
     void load(const xlnt::path &filename, const std::string &password);
 
+    /// <summary>
+    /// Interprets file with the given filename as an XLSX file and sets the content
+    /// of this workbook to match that file, reading it as described by options.
+    /// </summary>
+    void load(const xlnt::path &filename, const load_options &options);
+
     /// <summary>
     /// Interprets data in stream as an XLSX file and sets the content of this
     /// workbook to match that file.
@@ -578,6 +614,12 @@ public:
     /// </summary>
     void load(std::istream &stream, const std::string &password);
 
+    /// <summary>
+    /// Interprets data in stream as an XLSX file and sets the content of this
+    /// workbook to match that file, reading it as described by options.
+    /// </summary>
+    void load(std::istream &stream, const load_options &options);
+
     // View
 
     /// <summary>
@@ -679,6 +721,14 @@ public:
     /// </summary>
     void clear_formats();
 
+    /// <summary>
+    /// Removes formats, fonts, fills, borders, alignments and protections that are
+    /// no longer used by any cell or style and renumbers the remaining formats.
+    /// Changing the style of a cell leaves its previous format in place, so this
+    /// only needs to be called to reclaim memory. Saving does the same automatically.
+    /// </summary>
+    void compact_styles();
+
     // Styles
 
     /// <summary>
@@ -761,9 +811,9 @@ public:
     std::size_t add_shared_string(const rich_text &shared, bool allow_duplicates = false);
 
     /// <summary>
-    /// Returns a reference to the shared string ordered by id
+    /// Returns a reference to the shared strings ordered by id
     /// </summary>
-    const std::map<std::size_t, rich_text> &shared_strings_by_id() const;
+    const std::vector<rich_text> &shared_strings_by_id() const;
 
     /// <summary>
     /// Returns a reference to the shared string related to the specified index
@@ -772,15 +822,9 @@ public:
 
     /// <summary>
     /// Returns a reference to the shared strings being used by cells
-    /// in this workbook.
-    /// </summary>
-    std::unordered_map<rich_text, std::size_t, rich_text_hash> &shared_strings();
-
-    /// <summary>
-    /// Returns a reference to the shared strings being used by cells
-    /// in this workbook.
+    /// in this workbook, ordered by id.
     /// </summary>
-    const std::unordered_map<rich_text, std::size_t, rich_text_hash> &shared_strings() const;
+    const std::vector<rich_text> &shared_strings() const;
 
     // Thumbnail
 
@@ -845,6 +889,7 @@ public:
 
 private:
     friend class streaming_workbook_reader;
+    friend class streaming_workbook_writer;
     friend class worksheet;
     friend class detail::xlsx_consumer;
     friend class detail::xlsx_producer;
@@ -0,0 +1,135 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <xlnt/xlnt_config.hpp>
+#include <xlnt/cell/index_types.hpp>
+#include <xlnt/utils/optional.hpp>
+#include <xlnt/worksheet/page_setup.hpp>
+#include <xlnt/worksheet/range_reference.hpp>
+
+namespace xlnt {
+
+class path;
+
+/// <summary>
+/// What the workbook part and the head of a worksheet part say about the worksheet.
+/// </summary>
+struct XLNT_API sheet_summary
+{
+    /// <summary>
+    /// The title of the worksheet.
+    /// </summary>
+    std::string title;
+
+    /// <summary>
+    /// The sheetId of the worksheet in the workbook part.
+    /// </summary>
+    std::size_t id = 0;
+
+    /// <summary>
+    /// Whether the worksheet is visible, hidden or very hidden.
+    /// </summary>
+    sheet_state state = sheet_state::visible;
+
+    /// <summary>
+    /// The range given by the worksheet's dimension element, if it has one. This is
+    /// what the program that wrote the file claims the cells cover and isn't checked
+    /// against the cells themselves. An empty worksheet usually claims A1.
+    /// </summary>
+    optional<range_reference> dimension;
+
+    /// <summary>
+    /// The last row of dimension, i.e. the number of rows a reader will go through
+    /// counting from row 1, if the worksheet has a dimension element.
+    /// </summary>
+    optional<row_t> row_count;
+};
+
+/// <summary>
+/// Reads the list of worksheets in an XLSX package without loading the workbook.
+/// Only [Content_Types].xml, the workbook part and its relationships, and each
+/// worksheet part up to the start of its cells are read, so the cost doesn't
+/// depend on how many cells the worksheets hold.
+/// </summary>
+class XLNT_API workbook_probe
+{
+public:
+    /// <summary>
+    /// Probes the XLSX file held in data.
+    /// </summary>
+    explicit workbook_probe(const std::vector<std::uint8_t> &data);
+
+    /// <summary>
+    /// Probes the XLSX file with the given filename.
+    /// </summary>
+    explicit workbook_probe(const std::string &filename);
+
+#ifdef _MSC_VER
+    /// <summary>
+    /// Probes the XLSX file with the given filename.
+    /// </summary>
+    explicit workbook_probe(const std::wstring &filename);
+#endif
+
+    /// <summary>
+    /// Probes the XLSX file with the given filename.
+    /// </summary>
+    explicit workbook_probe(const path &filename);
+
+    /// <summary>
+    /// Probes the XLSX file read from stream.
+    /// </summary>
+    explicit workbook_probe(std::istream &stream);
+
+    /// <summary>
+    /// Returns the worksheets in the order the workbook lists them.
+    /// </summary>
+    const std::vector<sheet_summary> &sheets() const;
+
+    /// <summary>
+    /// Returns the titles of the worksheets in order.
+    /// </summary>
+    std::vector<std::string> sheet_titles() const;
+
+private:
+    /// <summary>
+    /// Fills sheets_ from the package read from stream.
+    /// </summary>
+    void probe(std::istream &stream);
+
+    /// <summary>
+    /// The worksheets found by probe.
+    /// </summary>
+    std::vector<sheet_summary> sheets_;
+};
+
+} // namespace xlnt
@@ -187,8 +187,8 @@ public:
     class cell cell(const cell_reference &reference);
 
     /// <summary>
-    /// Returns the cell at the given reference. If the cell doesn't exist, an
-    /// invalid_parameter exception will be thrown.
+    /// Returns the cell at the given reference. If the cell doesn't exist, a
+    /// std::out_of_range exception will be thrown.
     /// </summary>
     const class cell cell(const cell_reference &reference) const;
 
@@ -199,8 +199,8 @@ public:
     class cell cell(column_t column, row_t row);
 
     /// <summary>
-    /// Returns the cell at the given column and row. If the cell doesn't exist, an
-    /// invalid_parameter exception will be thrown.
+    /// Returns the cell at the given column and row. If the cell doesn't exist, a
+    /// std::out_of_range exception will be thrown.
     /// </summary>
     const class cell cell(column_t column, row_t row) const;
 
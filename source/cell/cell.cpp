@@ -271,10 +271,35 @@ void cell::value(const cell c)
 {
     d_->type_ = c.d_->type_;
     d_->value_numeric_ = c.d_->value_numeric_;
-    d_->value_text_ = c.d_->value_text_;
-    d_->hyperlink_ = c.d_->hyperlink_;
-    d_->formula_ = c.d_->formula_;
     d_->format_ = c.d_->format_;
+
+    // c may belong to another worksheet so its side table entries are copied
+    // field by field, keeping this cell's comment
+    auto text = c.d_->value_text();
+    auto formula = c.d_->has_formula() ? c.d_->formula() : std::string();
+    auto hyperlink = c.d_->has_hyperlink() ? *c.d_->find_hyperlink() : detail::hyperlink_impl();
+
+    d_->extras().value_text_ = text;
+
+    if (c.d_->has_formula())
+    {
+        d_->formula(formula.data(), formula.size());
+    }
+    else
+    {
+        d_->clear_formula();
+    }
+
+    if (c.d_->has_hyperlink())
+    {
+        d_->hyperlink() = hyperlink;
+    }
+    else
+    {
+        d_->clear_hyperlink();
+    }
+
+    d_->compact_extras();
 }
 
 void cell::value(const date &d)
@@ -366,7 +391,12 @@ cell &cell::operator=(const cell &rhs) = default;
 
 hyperlink cell::hyperlink() const
 {
-    return xlnt::hyperlink(&d_->hyperlink_.get());
+    if (!d_->has_hyperlink())
+    {
+        throw invalid_attribute();
+    }
+
+    return xlnt::hyperlink(&d_->hyperlink());
 }
 
 void cell::hyperlink(const std::string &url, const std::string &display)
@@ -379,7 +409,7 @@ void cell::hyperlink(const std::string &url, const std::string &display)
     auto ws = worksheet();
     auto &manifest = ws.workbook().manifest();
 
-    d_->hyperlink_ = detail::hyperlink_impl();
+    d_->hyperlink() = detail::hyperlink_impl();
 
     // check for existing relationships
     auto relationships = manifest.relationships(ws.path(), relationship_type::hyperlink);
@@ -387,7 +417,7 @@ void cell::hyperlink(const std::string &url, const std::string &display)
         [&url](xlnt::relationship rel) { return rel.target().path().string() == url; });
     if (relation != relationships.end())
     {
-        d_->hyperlink_.get().relationship = *relation;
+        d_->hyperlink().relationship = *relation;
     }
     else
     { // register a new relationship
@@ -397,16 +427,16 @@ void cell::hyperlink(const std::string &url, const std::string &display)
             uri(url),
             target_mode::external);
         // TODO: make manifest::register_relationship return the created relationship instead of rel id
-        d_->hyperlink_.get().relationship = manifest.relationship(ws.path(), rel_id);
+        d_->hyperlink().relationship = manifest.relationship(ws.path(), rel_id);
     }
     // if a value is already present, the display string is ignored
     if (has_value())
     {
-        d_->hyperlink_.get().display.set(to_string());
+        d_->hyperlink().display.set(to_string());
     }
     else
     {
-        d_->hyperlink_.get().display.set(display.empty() ? url : display);
+        d_->hyperlink().display.set(display.empty() ? url : display);
         value(hyperlink().display());
     }
 }
@@ -416,17 +446,17 @@ void cell::hyperlink(xlnt::cell target, const std::string &display)
     // TODO: should this computed value be a method on a cell?
     const auto cell_address = target.worksheet().title() + "!" + target.reference().to_string();
 
-    d_->hyperlink_ = detail::hyperlink_impl();
-    d_->hyperlink_.get().relationship = xlnt::relationship("", relationship_type::hyperlink,
+    d_->hyperlink() = detail::hyperlink_impl();
+    d_->hyperlink().relationship = xlnt::relationship("", relationship_type::hyperlink,
         uri(""), uri(cell_address), target_mode::internal);
     // if a value is already present, the display string is ignored
     if (has_value())
     {
-        d_->hyperlink_.get().display.set(to_string());
+        d_->hyperlink().display.set(to_string());
     }
     else
     {
-        d_->hyperlink_.get().display.set(display.empty() ? cell_address : display);
+        d_->hyperlink().display.set(display.empty() ? cell_address : display);
         value(hyperlink().display());
     }
 }
@@ -436,18 +466,18 @@ void cell::hyperlink(xlnt::range target, const std::string &display)
     // TODO: should this computed value be a method on a cell?
     const auto range_address = target.target_worksheet().title() + "!" + target.reference().to_string();
 
-    d_->hyperlink_ = detail::hyperlink_impl();
-    d_->hyperlink_.get().relationship = xlnt::relationship("", relationship_type::hyperlink,
+    d_->hyperlink() = detail::hyperlink_impl();
+    d_->hyperlink().relationship = xlnt::relationship("", relationship_type::hyperlink,
         uri(""), uri(range_address), target_mode::internal);
 
     // if a value is already present, the display string is ignored
     if (has_value())
     {
-        d_->hyperlink_.get().display.set(to_string());
+        d_->hyperlink().display.set(to_string());
     }
     else
     {
-        d_->hyperlink_.get().display.set(display.empty() ? range_address : display);
+        d_->hyperlink().display.set(display.empty() ? range_address : display);
         value(hyperlink().display());
     }
 }
@@ -461,11 +491,11 @@ void cell::formula(const std::string &formula)
 
     if (formula[0] == '=')
     {
-        d_->formula_ = formula.substr(1);
+        d_->formula(formula.data() + 1, formula.size() - 1);
     }
     else
     {
-        d_->formula_ = formula;
+        d_->formula(formula.data(), formula.size());
     }
 
     worksheet().register_calc_chain_in_manifest();
@@ -473,19 +503,24 @@ void cell::formula(const std::string &formula)
 
 bool cell::has_formula() const
 {
-    return d_->formula_.is_set();
+    return d_->has_formula();
 }
 
 std::string cell::formula() const
 {
-    return d_->formula_.get();
+    if (!d_->has_formula())
+    {
+        throw invalid_attribute();
+    }
+
+    return d_->formula();
 }
 
 void cell::clear_formula()
 {
     if (has_formula())
     {
-        d_->formula_.clear();
+        d_->clear_formula();
         worksheet().garbage_collect_formulae();
     }
 }
@@ -506,7 +541,7 @@ void cell::error(const std::string &error)
         throw invalid_data_type();
     }
 
-    d_->value_text_.plain_text(error, false);
+    d_->extras().value_text_.plain_text(error, false);
     d_->type_ = type::error;
 }
 
@@ -597,7 +632,11 @@ protection cell::computed_protection() const
 void cell::clear_value()
 {
     d_->value_numeric_ = 0;
-    d_->value_text_.clear();
+    if (d_->extras_ != 0)
+    {
+        d_->extras().value_text_.clear();
+        d_->compact_extras();
+    }
     d_->type_ = cell::type::empty;
     clear_formula();
 }
@@ -718,7 +757,7 @@ XLNT_API rich_text cell::value() const
         return workbook().shared_strings(static_cast<std::size_t>(d_->value_numeric_));
     }
 
-    return d_->value_text_;
+    return d_->value_text();
 }
 
 bool cell::has_value() const
@@ -751,7 +790,7 @@ std::string cell::to_string() const
 
 bool cell::has_format() const
 {
-    return d_->format_.is_set();
+    return d_->format_ != nullptr;
 }
 
 void cell::format(const class format new_format)
@@ -839,10 +878,10 @@ void cell::value(const std::string &value_string, bool infer_type)
 
 void cell::clear_format()
 {
-    if (d_->format_.is_set())
+    if (d_->format_ != nullptr)
     {
         format().d_->references -= format().d_->references > 0 ? 1 : 0;
-        d_->format_.clear();
+        d_->format_ = nullptr;
     }
 }
 
@@ -900,22 +939,22 @@ bool cell::has_style() const
 
 format cell::modifiable_format()
 {
-    if (!d_->format_.is_set())
+    if (d_->format_ == nullptr)
     {
         throw invalid_attribute();
     }
 
-    return xlnt::format(d_->format_.get());
+    return xlnt::format(d_->format_);
 }
 
 const format cell::format() const
 {
-    if (!d_->format_.is_set())
+    if (d_->format_ == nullptr)
     {
         throw invalid_attribute();
     }
 
-    return xlnt::format(d_->format_.get());
+    return xlnt::format(d_->format_);
 }
 
 alignment cell::alignment() const
@@ -950,14 +989,14 @@ protection cell::protection() const
 
 bool cell::has_hyperlink() const
 {
-    return d_->hyperlink_.is_set();
+    return d_->has_hyperlink();
 }
 
 // comment
 
 bool cell::has_comment()
 {
-    return d_->comment_.is_set();
+    return d_->has_comment();
 }
 
 void cell::clear_comment()
@@ -965,7 +1004,8 @@ void cell::clear_comment()
     if (has_comment())
     {
         d_->parent_->comments_.erase(reference().to_string());
-        d_->comment_.clear();
+        d_->extras().comment_.clear();
+        d_->compact_extras();
     }
 }
 
@@ -976,7 +1016,7 @@ class comment cell::comment()
         throw xlnt::exception("cell has no comment");
     }
 
-    return *d_->comment_.get();
+    return *d_->find_extras()->comment_.get();
 }
 
 void cell::comment(const std::string &text, const std::string &author)
@@ -993,12 +1033,12 @@ void cell::comment(const class comment &new_comment)
 {
     if (has_comment())
     {
-        *d_->comment_.get() = new_comment;
+        *d_->extras().comment_.get() = new_comment;
     }
     else
     {
         d_->parent_->comments_[reference().to_string()] = new_comment;
-        d_->comment_.set(&d_->parent_->comments_[reference().to_string()]);
+        d_->extras().comment_.set(&d_->parent_->comments_[reference().to_string()]);
     }
 
     // offset comment 5 pixels down and 5 pixels right of the top right corner of the cell
@@ -1006,7 +1046,7 @@ void cell::comment(const class comment &new_comment)
     cell_position.first += static_cast<int>(width()) + 5;
     cell_position.second += 5;
 
-    d_->comment_.get()->position(cell_position.first, cell_position.second);
+    d_->extras().comment_.get()->position(cell_position.first, cell_position.second);
 
     worksheet().register_comments_in_manifest();
 }
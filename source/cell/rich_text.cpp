@@ -56,6 +56,9 @@ rich_text &rich_text::operator=(const rich_text &rhs)
     runs_ = rhs.runs_;
     phonetic_runs_ = rhs.phonetic_runs_;
     phonetic_properties_ = rhs.phonetic_properties_;
+    plain_text_ = rhs.plain_text_;
+    plain_preserve_space_ = rhs.plain_preserve_space_;
+    is_plain_ = rhs.is_plain_;
     return *this;
 }
 
@@ -69,16 +72,26 @@ void rich_text::clear()
     runs_.clear();
     phonetic_runs_.clear();
     phonetic_properties_.clear();
+    plain_text_.clear();
+    plain_preserve_space_ = false;
+    is_plain_ = false;
 }
 
 void rich_text::plain_text(const std::string &s, bool preserve_space = false)
 {
     clear();
-    add_run(rich_text_run{s, {}, preserve_space});
+    plain_text_ = s;
+    plain_preserve_space_ = preserve_space;
+    is_plain_ = true;
 }
 
 std::string rich_text::plain_text() const
 {
+    if (is_plain_)
+    {
+        return plain_text_;
+    }
+
     if (runs_.size() == 1)
     {
         return runs_.begin()->first;
@@ -90,16 +103,48 @@ std::string rich_text::plain_text() const
 
 std::vector<rich_text_run> rich_text::runs() const
 {
+    if (is_plain_)
+    {
+        return {rich_text_run{plain_text_, optional<font>(), plain_preserve_space_}};
+    }
+
     return runs_;
 }
 
 void rich_text::runs(const std::vector<rich_text_run> &new_runs)
 {
-    runs_ = new_runs;
+    runs_.clear();
+    plain_text_.clear();
+    plain_preserve_space_ = false;
+    is_plain_ = false;
+
+    for (const auto &run : new_runs)
+    {
+        add_run(run);
+    }
 }
 
 void rich_text::add_run(const rich_text_run &t)
 {
+    // a single run without a font is stored as plain text and only turned
+    // into a run once a second run is added
+    if (!is_plain_ && runs_.empty() && !t.second.is_set())
+    {
+        plain_text_ = t.first;
+        plain_preserve_space_ = t.preserve_space;
+        is_plain_ = true;
+
+        return;
+    }
+
+    if (is_plain_)
+    {
+        runs_.push_back(rich_text_run{plain_text_, optional<font>(), plain_preserve_space_});
+        plain_text_.clear();
+        plain_preserve_space_ = false;
+        is_plain_ = false;
+    }
+
     runs_.push_back(t);
 }
 
@@ -135,6 +180,15 @@ void rich_text::phonetic_properties(const phonetic_pr &phonetic_props)
 
 bool rich_text::operator==(const rich_text &rhs) const
 {
+    // a single unformatted run is always stored as plain text, so plain text
+    // never equals text made of runs
+    if (is_plain_ != rhs.is_plain_) return false;
+
+    if (is_plain_ && (plain_text_ != rhs.plain_text_ || plain_preserve_space_ != rhs.plain_preserve_space_))
+    {
+        return false;
+    }
+
     if (runs_.size() != rhs.runs_.size()) return false;
 
     for (std::size_t i = 0; i < runs_.size(); i++)
@@ -156,7 +210,11 @@ bool rich_text::operator==(const rich_text &rhs) const
 
 bool rich_text::operator==(const std::string &rhs) const
 {
-    return *this == rich_text(rhs);
+    return is_plain_
+        && plain_text_ == rhs
+        && plain_preserve_space_ == has_trailing_whitespace(rhs)
+        && phonetic_runs_.empty()
+        && !phonetic_properties_.is_set();
 }
 
 bool rich_text::operator!=(const rich_text &rhs) const
@@ -169,4 +227,21 @@ bool rich_text::operator!=(const std::string &rhs) const
     return !(*this == rhs);
 }
 
+std::size_t rich_text_hash::operator()(const rich_text &k) const
+{
+    if (k.is_plain_)
+    {
+        return std::hash<std::string>()(k.plain_text_);
+    }
+
+    std::size_t res = 0;
+
+    for (const auto &r : k.runs_)
+    {
+        res ^= std::hash<std::string>()(r.first);
+    }
+
+    return res;
+}
+
 } // namespace xlnt
@@ -0,0 +1,292 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xlnt {
+namespace detail {
+
+/// <summary>
+/// Storage for strings owned by a worksheet. Strings are appended to a single
+/// buffer and referred to by offset, so copying a worksheet copies its strings
+/// in one go and teardown is a single deallocation. Released space is counted
+/// rather than reused and is reclaimed by compact(), which the owner calls
+/// once fragmented() says that enough of the buffer is unused.
+/// </summary>
+class string_arena
+{
+public:
+    /// <summary>
+    /// The location of a string in the arena.
+    /// </summary>
+    struct handle
+    {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    /// <summary>
+    /// Copies the given characters into the arena and returns their location.
+    /// </summary>
+    handle store(const char *data, std::size_t size)
+    {
+        auto result = handle();
+        result.offset = buffer_.size();
+        result.size = size;
+        buffer_.insert(buffer_.end(), data, data + size);
+
+        return result;
+    }
+
+    /// <summary>
+    /// Replaces the string at existing with the given characters, reusing its
+    /// space if the new string fits.
+    /// </summary>
+    void assign(handle &existing, const char *data, std::size_t size)
+    {
+        if (size <= existing.size)
+        {
+            std::copy(data, data + size, buffer_.begin() + static_cast<std::ptrdiff_t>(existing.offset));
+            unused_ += existing.size - size;
+            existing.size = size;
+        }
+        else
+        {
+            release(existing);
+            existing = store(data, size);
+        }
+    }
+
+    /// <summary>
+    /// Marks the string at location as no longer used. Its space is reclaimed
+    /// by the next compact().
+    /// </summary>
+    void release(handle location)
+    {
+        unused_ += location.size;
+    }
+
+    /// <summary>
+    /// Returns true if more of the buffer is unused than used and the unused
+    /// part is big enough to be worth a compact().
+    /// </summary>
+    bool fragmented() const
+    {
+        return unused_ >= min_compaction && unused_ > buffer_.size() - unused_;
+    }
+
+    /// <summary>
+    /// Moves every string still in use to the front of the buffer.
+    /// for_each_handle is called with a function that must in turn be called
+    /// with every handle still in use, which it updates to the new location.
+    /// </summary>
+    template <typename ForEachHandle>
+    void compact(ForEachHandle for_each_handle)
+    {
+        std::vector<char> used;
+        used.reserve(buffer_.size() - unused_);
+
+        const std::function<void(handle &)> relocate = [this, &used](handle &location) {
+            const auto first = buffer_.begin() + static_cast<std::ptrdiff_t>(location.offset);
+            location.offset = used.size();
+            used.insert(used.end(), first, first + static_cast<std::ptrdiff_t>(location.size));
+        };
+
+        for_each_handle(relocate);
+
+        buffer_.swap(used);
+        unused_ = 0;
+    }
+
+    /// <summary>
+    /// Returns a copy of the string at the given location.
+    /// </summary>
+    std::string get(handle location) const
+    {
+        return location.size == 0 ? std::string() : std::string(&buffer_[location.offset], location.size);
+    }
+
+    /// <summary>
+    /// Returns true if the string at location equals the given characters.
+    /// </summary>
+    bool equals(handle location, const char *data, std::size_t size) const
+    {
+        return location.size == size
+            && (size == 0 || std::memcmp(&buffer_[location.offset], data, size) == 0);
+    }
+
+    /// <summary>
+    /// Returns the number of characters in the buffer, including unused ones.
+    /// </summary>
+    std::size_t size() const
+    {
+        return buffer_.size();
+    }
+
+    /// <summary>
+    /// Ensures that n more characters can be stored without reallocating.
+    /// </summary>
+    void reserve(std::size_t n)
+    {
+        buffer_.reserve(buffer_.size() + n);
+    }
+
+    /// <summary>
+    /// Releases every string at once.
+    /// </summary>
+    void clear()
+    {
+        std::vector<char>().swap(buffer_);
+        unused_ = 0;
+    }
+
+private:
+    /// <summary>
+    /// The fewest unused characters fragmented() reports, so that a buffer
+    /// holding a handful of strings isn't copied every time one is replaced.
+    /// </summary>
+    static const std::size_t min_compaction = 4096;
+
+    std::vector<char> buffer_;
+    std::size_t unused_ = 0;
+};
+
+/// <summary>
+/// A table of T addressed by one-based index, where zero means "no entry".
+/// Entries are allocated a chunk at a time and never move, so references into
+/// the table stay valid as it grows. Released entries are reset and reused.
+/// </summary>
+template <typename T>
+class chunked_table
+{
+public:
+    chunked_table() = default;
+
+    chunked_table(const chunked_table &other)
+    {
+        *this = other;
+    }
+
+    chunked_table &operator=(const chunked_table &other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        chunks_.clear();
+
+        for (const auto &other_chunk : other.chunks_)
+        {
+            chunks_.emplace_back(new T[chunk_size]);
+            std::copy(other_chunk.get(), other_chunk.get() + chunk_size, chunks_.back().get());
+        }
+
+        size_ = other.size_;
+        free_ = other.free_;
+
+        return *this;
+    }
+
+    /// <summary>
+    /// Returns the index of an empty entry.
+    /// </summary>
+    std::uint32_t allocate()
+    {
+        if (!free_.empty())
+        {
+            auto index = free_.back();
+            free_.pop_back();
+
+            return index;
+        }
+
+        if (size_ == chunks_.size() * chunk_size)
+        {
+            chunks_.emplace_back(new T[chunk_size]);
+        }
+
+        return ++size_;
+    }
+
+    /// <summary>
+    /// Resets the entry at index and makes it available for reuse.
+    /// </summary>
+    void release(std::uint32_t index)
+    {
+        (*this)[index] = T();
+        free_.push_back(index);
+    }
+
+    T &operator[](std::uint32_t index)
+    {
+        return chunks_[(index - 1) / chunk_size][(index - 1) % chunk_size];
+    }
+
+    const T &operator[](std::uint32_t index) const
+    {
+        return chunks_[(index - 1) / chunk_size][(index - 1) % chunk_size];
+    }
+
+    /// <summary>
+    /// Calls f with every entry that has been allocated, including released
+    /// ones, which hold a default constructed T.
+    /// </summary>
+    template <typename F>
+    void for_each(F f)
+    {
+        for (std::uint32_t index = 1; index <= size_; ++index)
+        {
+            f((*this)[index]);
+        }
+    }
+
+    /// <summary>
+    /// Releases every entry and all storage at once.
+    /// </summary>
+    void clear()
+    {
+        chunks_.clear();
+        size_ = 0;
+        free_.clear();
+    }
+
+private:
+    static const std::uint32_t chunk_size = 64;
+
+    std::vector<std::unique_ptr<T[]>> chunks_;
+    std::uint32_t size_ = 0;
+    std::vector<std::uint32_t> free_;
+};
+
+} // namespace detail
+} // namespace xlnt
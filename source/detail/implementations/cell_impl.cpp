@@ -25,19 +25,221 @@
 #include <xlnt/worksheet/worksheet.hpp>
 
 #include <detail/implementations/cell_impl.hpp>
+#include <detail/implementations/shared_formula.hpp>
+#include <detail/implementations/worksheet_impl.hpp>
+
+namespace {
+
+const xlnt::rich_text &empty_text()
+{
+    static const xlnt::rich_text *text = new xlnt::rich_text();
+    return *text;
+}
+
+} // namespace
 
 namespace xlnt {
 namespace detail {
 
 cell_impl::cell_impl()
-    : type_(cell_type::empty),
-      parent_(nullptr),
+    : parent_(nullptr),
+      format_(nullptr),
+      value_numeric_(0),
       column_(1),
       row_(1),
+      extras_(0),
+      type_(cell_type::empty),
       is_merged_(false),
       phonetics_visible_(false),
-      value_numeric_(0)
+      shared_formula_(0)
+{
+}
+
+const cell_extras *cell_impl::find_extras() const
+{
+    return extras_ == 0 ? nullptr : &parent_->cell_extras_[extras_];
+}
+
+cell_extras &cell_impl::extras()
+{
+    if (extras_ == 0)
+    {
+        extras_ = parent_->cell_extras_.allocate();
+    }
+
+    return parent_->cell_extras_[extras_];
+}
+
+void cell_impl::compact_extras()
+{
+    if (extras_ != 0 && find_extras()->empty())
+    {
+        release_extras();
+    }
+}
+
+void cell_impl::release_extras()
 {
+    if (extras_ == 0)
+    {
+        return;
+    }
+
+    auto &formula = extras().formula_;
+
+    if (formula.is_set())
+    {
+        parent_->formulae_.release(formula.get());
+    }
+
+    clear_hyperlink();
+    parent_->cell_extras_.release(extras_);
+    extras_ = 0;
+
+    parent_->compact_formulae();
+}
+
+const rich_text &cell_impl::value_text() const
+{
+    auto extras = find_extras();
+    return extras == nullptr ? empty_text() : extras->value_text_;
+}
+
+bool cell_impl::has_formula() const
+{
+    if (shared_formula_ != 0)
+    {
+        return true;
+    }
+
+    auto extras = find_extras();
+    return extras != nullptr && extras->formula_.is_set();
+}
+
+std::string cell_impl::formula() const
+{
+    if (shared_formula_ != 0)
+    {
+        const auto &shared = parent_->shared_formulas_[shared_formula_ - 1];
+
+        if (shared.row == row_ && shared.column == column_.index)
+        {
+            return shared.formula;
+        }
+
+        return shift_formula(shared.formula,
+            static_cast<std::int64_t>(row_) - shared.row,
+            static_cast<std::int64_t>(column_.index) - shared.column);
+    }
+
+    return parent_->formulae_.get(find_extras()->formula_.get());
+}
+
+void cell_impl::formula(const char *data, std::size_t size)
+{
+    shared_formula_ = 0;
+
+    auto &formula = extras().formula_;
+
+    if (formula.is_set())
+    {
+        parent_->formulae_.assign(formula.get(), data, size);
+        parent_->compact_formulae();
+    }
+    else
+    {
+        formula = parent_->formulae_.store(data, size);
+    }
+}
+
+void cell_impl::clear_formula()
+{
+    shared_formula_ = 0;
+
+    if (has_formula())
+    {
+        auto &formula = extras().formula_;
+        parent_->formulae_.release(formula.get());
+        formula.clear();
+        compact_extras();
+        parent_->compact_formulae();
+    }
+}
+
+void cell_impl::unshare_formula()
+{
+    if (shared_formula_ != 0)
+    {
+        const auto text = formula();
+        formula(text.data(), text.size());
+    }
+}
+
+bool cell_impl::has_hyperlink() const
+{
+    auto extras = find_extras();
+    return extras != nullptr && extras->hyperlink_ != 0;
+}
+
+const hyperlink_impl *cell_impl::find_hyperlink() const
+{
+    return has_hyperlink() ? &parent_->hyperlinks_[find_extras()->hyperlink_] : nullptr;
+}
+
+hyperlink_impl &cell_impl::hyperlink()
+{
+    auto &index = extras().hyperlink_;
+
+    if (index == 0)
+    {
+        index = parent_->hyperlinks_.allocate();
+    }
+
+    return parent_->hyperlinks_[index];
+}
+
+void cell_impl::clear_hyperlink()
+{
+    if (has_hyperlink())
+    {
+        auto &index = extras().hyperlink_;
+        parent_->hyperlinks_.release(index);
+        index = 0;
+    }
+}
+
+bool cell_impl::has_comment() const
+{
+    auto extras = find_extras();
+    return extras != nullptr && extras->comment_.is_set();
+}
+
+bool operator==(const cell_impl &lhs, const cell_impl &rhs)
+{
+    // not comparing parent
+    if (!(lhs.type_ == rhs.type_
+            && lhs.column_ == rhs.column_
+            && lhs.row_ == rhs.row_
+            && lhs.is_merged_ == rhs.is_merged_
+            && lhs.phonetics_visible_ == rhs.phonetics_visible_
+            && float_equals(lhs.value_numeric_, rhs.value_numeric_)
+            && (lhs.format_ == nullptr) == (rhs.format_ == nullptr)
+            && (lhs.format_ == nullptr || *lhs.format_ == *rhs.format_)))
+    {
+        return false;
+    }
+
+    const auto empty = cell_extras();
+    const auto &lhs_extras = lhs.extras_ == 0 ? empty : *lhs.find_extras();
+    const auto &rhs_extras = rhs.extras_ == 0 ? empty : *rhs.find_extras();
+
+    return lhs_extras.value_text_ == rhs_extras.value_text_
+        && lhs.has_formula() == rhs.has_formula()
+        && (!lhs.has_formula() || lhs.formula() == rhs.formula())
+        && lhs.has_hyperlink() == rhs.has_hyperlink()
+        && (!lhs.has_hyperlink() || *lhs.find_hyperlink() == *rhs.find_hyperlink())
+        && (lhs_extras.comment_.is_set() == rhs_extras.comment_.is_set()
+            && (!lhs_extras.comment_.is_set() || *lhs_extras.comment_.get() == *rhs_extras.comment_.get()));
 }
 
 } // namespace detail
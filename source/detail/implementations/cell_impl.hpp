@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include <xlnt/cell/cell_type.hpp>
@@ -31,6 +32,7 @@
 #include <xlnt/cell/rich_text.hpp>
 #include <xlnt/packaging/relationship.hpp>
 #include <xlnt/utils/optional.hpp>
+#include <detail/implementations/arena.hpp>
 #include <detail/implementations/format_impl.hpp>
 #include <detail/implementations/hyperlink_impl.hpp>
 //#include "../numeric_utils.hpp"
@@ -40,6 +42,33 @@ namespace detail {
 
 struct worksheet_impl;
 
+/// <summary>
+/// Attributes that only a minority of cells have. These are kept in a side table
+/// owned by the worksheet so that ordinary cells don't pay for them.
+/// </summary>
+struct cell_extras
+{
+    rich_text value_text_;
+
+    /// <summary>
+    /// The location of the formula text in the worksheet's formula arena.
+    /// </summary>
+    optional<string_arena::handle> formula_;
+
+    /// <summary>
+    /// Index of the hyperlink in the worksheet's hyperlink table or zero.
+    /// Hyperlinks are large and rare so they get a table of their own.
+    /// </summary>
+    std::uint32_t hyperlink_ = 0;
+
+    optional<comment *> comment_;
+
+    bool empty() const
+    {
+        return value_text_ == rich_text() && !formula_.is_set() && hyperlink_ == 0 && !comment_.is_set();
+    }
+};
+
 struct cell_impl
 {
     cell_impl();
@@ -48,45 +77,86 @@ struct cell_impl
     cell_impl &operator=(const cell_impl &other) = default;
     cell_impl &operator=(cell_impl &&other) = default;
 
-    cell_type type_;
-
     worksheet_impl *parent_;
+    format_impl *format_;
+
+    /// <summary>
+    /// The numeric value of the cell or, for shared strings, the index of the string
+    /// in the workbook's shared string table.
+    /// </summary>
+    double value_numeric_;
 
     column_t column_;
     row_t row_;
 
+    /// <summary>
+    /// One plus the index of this cell's entry in parent_->cell_extras_ or zero
+    /// if the cell has no text, formula, hyperlink or comment.
+    /// </summary>
+    std::uint32_t extras_;
+
+    cell_type type_;
+
     bool is_merged_;
     bool phonetics_visible_;
 
-    rich_text value_text_;
-    double value_numeric_;
+    /// <summary>
+    /// One plus the index of the shared formula this cell belongs to in
+    /// parent_->shared_formulas_ or zero. This fits in what would otherwise
+    /// be padding at the end of the struct.
+    /// </summary>
+    std::uint32_t shared_formula_;
 
-    optional<std::string> formula_;
-    optional<hyperlink_impl> hyperlink_;
-    optional<format_impl *> format_;
-    optional<comment *> comment_;
+    /// <summary>
+    /// Returns the side table entry of this cell or nullptr if it doesn't have one.
+    /// </summary>
+    const cell_extras *find_extras() const;
+
+    /// <summary>
+    /// Returns the side table entry of this cell, creating it if necessary.
+    /// </summary>
+    cell_extras &extras();
+
+    /// <summary>
+    /// Returns the side table entry to the worksheet for reuse if it no longer holds anything.
+    /// </summary>
+    void compact_extras();
+
+    /// <summary>
+    /// Returns the side table entry to the worksheet for reuse, discarding its contents.
+    /// </summary>
+    void release_extras();
+
+    const rich_text &value_text() const;
+
+    bool has_formula() const;
+    std::string formula() const;
+    void formula(const char *data, std::size_t size);
+    void clear_formula();
+
+    /// <summary>
+    /// Replaces this cell's part in a shared formula, if any, with a formula of its own.
+    /// </summary>
+    void unshare_formula();
+
+    bool has_hyperlink() const;
+    const hyperlink_impl *find_hyperlink() const;
+
+    /// <summary>
+    /// Returns the hyperlink of this cell, creating an empty one if necessary.
+    /// </summary>
+    hyperlink_impl &hyperlink();
+    void clear_hyperlink();
+
+    bool has_comment() const;
 
     bool is_garbage_collectible() const
     {
-        return !(type_ != cell_type::empty || is_merged_ || phonetics_visible_ || formula_.is_set() || format_.is_set() || hyperlink_.is_set());
+        return !(type_ != cell_type::empty || is_merged_ || phonetics_visible_ || format_ != nullptr || has_formula() || has_hyperlink());
     }
 };
 
-inline bool operator==(const cell_impl &lhs, const cell_impl &rhs)
-{
-    // not comparing parent
-    return lhs.type_ == rhs.type_
-        && lhs.column_ == rhs.column_
-        && lhs.row_ == rhs.row_
-        && lhs.is_merged_ == rhs.is_merged_
-        && lhs.phonetics_visible_ == rhs.phonetics_visible_
-        && lhs.value_text_ == rhs.value_text_
-        && float_equals(lhs.value_numeric_, rhs.value_numeric_)
-        && lhs.formula_ == rhs.formula_
-        && lhs.hyperlink_ == rhs.hyperlink_
-        && (lhs.format_.is_set() == rhs.format_.is_set() && (!lhs.format_.is_set() || *lhs.format_.get() == *rhs.format_.get()))
-        && (lhs.comment_.is_set() == rhs.comment_.is_set() && (!lhs.comment_.is_set() || *lhs.comment_.get() == *rhs.comment_.get()));
-}
+bool operator==(const cell_impl &lhs, const cell_impl &rhs);
 
 } // namespace detail
 } // namespace xlnt
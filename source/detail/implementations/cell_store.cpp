@@ -0,0 +1,455 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#include <detail/constants.hpp>
+#include <detail/implementations/cell_store.hpp>
+
+namespace {
+
+// the first chunk is small so that tiny sheets stay cheap, later chunks double
+// up to this size
+const std::size_t min_chunk_size = 16;
+const std::size_t max_chunk_size = 4096;
+
+bool column_less(const xlnt::detail::cell_impl *cell, xlnt::column_t column)
+{
+    return cell->column_ < column;
+}
+
+} // namespace
+
+namespace xlnt {
+namespace detail {
+
+cell_store::cell_store()
+    : last_row_(rows_.end())
+{
+}
+
+cell_store::cell_store(const cell_store &other)
+    : cell_store()
+{
+    *this = other;
+}
+
+cell_store::cell_store(cell_store &&other)
+    : cell_store()
+{
+    *this = std::move(other);
+}
+
+cell_store::~cell_store()
+{
+}
+
+cell_store &cell_store::operator=(const cell_store &other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    clear();
+    reserve(other.size_);
+
+    for (const auto &other_row : other.rows_)
+    {
+        auto &cells = rows_.emplace_hint(rows_.end(), other_row.first, row_cells())->second;
+        cells.reserve(other_row.second.size());
+
+        for (const auto *other_cell : other_row.second)
+        {
+            auto cell = allocate();
+            *cell = *other_cell;
+            cells.push_back(cell);
+        }
+    }
+
+    size_ = other.size_;
+    lowest_column_ = other.lowest_column_;
+    highest_column_ = other.highest_column_;
+    columns_stale_ = other.columns_stale_;
+
+    return *this;
+}
+
+cell_store &cell_store::operator=(cell_store &&other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    rows_ = std::move(other.rows_);
+    chunks_ = std::move(other.chunks_);
+    chunk_capacity_ = other.chunk_capacity_;
+    chunk_used_ = other.chunk_used_;
+    free_ = std::move(other.free_);
+    size_ = other.size_;
+    last_row_ = rows_.end();
+    lowest_column_ = other.lowest_column_;
+    highest_column_ = other.highest_column_;
+    columns_stale_ = other.columns_stale_;
+
+    other.clear();
+
+    return *this;
+}
+
+cell_store::row_map::iterator cell_store::find_row(row_t row) const
+{
+    if (last_row_ != rows_.end() && last_row_->first == row)
+    {
+        return last_row_;
+    }
+
+    auto match = rows_.find(row);
+
+    if (match != rows_.end())
+    {
+        last_row_ = match;
+    }
+
+    return match;
+}
+
+cell_store::row_map::iterator cell_store::erase_row_entry(row_map::iterator row)
+{
+    if (row == last_row_)
+    {
+        last_row_ = rows_.end();
+    }
+
+    return rows_.erase(row);
+}
+
+cell_impl *cell_store::find(column_t column, row_t row) const
+{
+    auto row_iter = find_row(row);
+
+    if (row_iter == rows_.end())
+    {
+        return nullptr;
+    }
+
+    const auto &cells = row_iter->second;
+    auto match = std::lower_bound(cells.begin(), cells.end(), column, column_less);
+
+    return match != cells.end() && (*match)->column_ == column ? *match : nullptr;
+}
+
+std::pair<cell_impl *, bool> cell_store::emplace(column_t column, row_t row)
+{
+    auto row_iter = find_row(row);
+
+    if (row_iter == rows_.end())
+    {
+        // rows are usually created in ascending order, in which case the
+        // new row belongs at the end and no tree search is needed
+        row_iter = !rows_.empty() && rows_.rbegin()->first < row
+            ? rows_.emplace_hint(rows_.end(), row, row_cells())
+            : rows_.emplace(row, row_cells()).first;
+        last_row_ = row_iter;
+    }
+
+    auto &cells = row_iter->second;
+    auto position = cells.end();
+
+    // same for columns within a row
+    if (!cells.empty() && !(cells.back()->column_ < column))
+    {
+        position = std::lower_bound(cells.begin(), cells.end(), column, column_less);
+
+        if ((*position)->column_ == column)
+        {
+            return {*position, false};
+        }
+    }
+
+    auto cell = allocate();
+    cell->column_ = column;
+    cell->row_ = row;
+    cells.insert(position, cell);
+
+    if (size_++ == 0)
+    {
+        lowest_column_ = highest_column_ = column;
+        columns_stale_ = false;
+    }
+    else
+    {
+        lowest_column_ = std::min(lowest_column_, column);
+        highest_column_ = std::max(highest_column_, column);
+    }
+
+    return {cell, true};
+}
+
+bool cell_store::erase(column_t column, row_t row)
+{
+    auto row_iter = find_row(row);
+
+    if (row_iter == rows_.end())
+    {
+        return false;
+    }
+
+    auto &cells = row_iter->second;
+    auto match = std::lower_bound(cells.begin(), cells.end(), column, column_less);
+
+    if (match == cells.end() || (*match)->column_ != column)
+    {
+        return false;
+    }
+
+    release_column(column);
+    release(*match);
+    cells.erase(match);
+
+    if (cells.empty())
+    {
+        erase_row_entry(row_iter);
+    }
+
+    return true;
+}
+
+void cell_store::erase_row(row_t row)
+{
+    auto row_iter = find_row(row);
+
+    if (row_iter == rows_.end())
+    {
+        return;
+    }
+
+    release_column(row_iter->second.front()->column_);
+    release_column(row_iter->second.back()->column_);
+
+    for (auto cell : row_iter->second)
+    {
+        release(cell);
+    }
+
+    erase_row_entry(row_iter);
+}
+
+void cell_store::clear()
+{
+    rows_.clear();
+    last_row_ = rows_.end();
+    chunks_.clear();
+    chunk_capacity_ = 0;
+    chunk_used_ = 0;
+    free_.clear();
+    size_ = 0;
+    columns_stale_ = false;
+}
+
+void cell_store::reserve(std::size_t n)
+{
+    const auto available = free_.size() + (chunk_capacity_ - chunk_used_);
+
+    if (available >= n)
+    {
+        return;
+    }
+
+    // hand the unused tail of the current chunk to the free list, in reverse
+    // so that it's still consumed in address order, then start a chunk that
+    // can hold everything else
+    for (auto i = chunk_capacity_; i > chunk_used_; --i)
+    {
+        free_.push_back(&chunks_.back()[i - 1]);
+    }
+
+    const auto needed = n - free_.size();
+    chunks_.emplace_back(new cell_impl[needed]);
+    chunk_capacity_ = needed;
+    chunk_used_ = 0;
+}
+
+std::size_t cell_store::size() const
+{
+    return size_;
+}
+
+bool cell_store::empty() const
+{
+    return size_ == 0;
+}
+
+const cell_store::row_map &cell_store::rows() const
+{
+    return rows_;
+}
+
+row_t cell_store::lowest_row() const
+{
+    return rows_.begin()->first;
+}
+
+row_t cell_store::highest_row() const
+{
+    return rows_.rbegin()->first;
+}
+
+column_t cell_store::lowest_column() const
+{
+    refresh_columns();
+    return lowest_column_;
+}
+
+column_t cell_store::highest_column() const
+{
+    refresh_columns();
+    return highest_column_;
+}
+
+const cell_store::row_cells *cell_store::row(row_t row) const
+{
+    auto row_iter = find_row(row);
+    return row_iter == rows_.end() ? nullptr : &row_iter->second;
+}
+
+cell_impl *cell_store::first_in_row(row_t row, column_t column) const
+{
+    auto cells = this->row(row);
+
+    if (cells == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto match = std::lower_bound(cells->begin(), cells->end(), column, column_less);
+
+    return match == cells->end() ? nullptr : *match;
+}
+
+cell_impl *cell_store::last_in_row(row_t row, column_t column) const
+{
+    auto cells = this->row(row);
+
+    if (cells == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto match = std::upper_bound(cells->begin(), cells->end(), column,
+        [](column_t value, const cell_impl *cell) { return value < cell->column_; });
+
+    return match == cells->begin() ? nullptr : *(match - 1);
+}
+
+cell_store::iterator cell_store::begin()
+{
+    return iterator(rows_.begin(), 0);
+}
+
+cell_store::iterator cell_store::end()
+{
+    return iterator(rows_.end(), 0);
+}
+
+cell_store::const_iterator cell_store::begin() const
+{
+    return const_iterator(row_map::const_iterator(rows_.begin()), 0);
+}
+
+cell_store::const_iterator cell_store::end() const
+{
+    return const_iterator(row_map::const_iterator(rows_.end()), 0);
+}
+
+bool cell_store::operator==(const cell_store &other) const
+{
+    if (size_ != other.size_ || rows_.size() != other.rows_.size())
+    {
+        return false;
+    }
+
+    return std::equal(begin(), end(), other.begin());
+}
+
+bool cell_store::operator!=(const cell_store &other) const
+{
+    return !(*this == other);
+}
+
+cell_impl *cell_store::allocate()
+{
+    if (!free_.empty())
+    {
+        auto cell = free_.back();
+        free_.pop_back();
+
+        return cell;
+    }
+
+    if (chunk_used_ == chunk_capacity_)
+    {
+        chunk_capacity_ = std::min(max_chunk_size, std::max(min_chunk_size, chunk_capacity_ * 2));
+        chunks_.emplace_back(new cell_impl[chunk_capacity_]);
+        chunk_used_ = 0;
+    }
+
+    return &chunks_.back()[chunk_used_++];
+}
+
+void cell_store::release_column(column_t column)
+{
+    if (column == lowest_column_ || column == highest_column_)
+    {
+        columns_stale_ = true;
+    }
+}
+
+void cell_store::refresh_columns() const
+{
+    if (!columns_stale_)
+    {
+        return;
+    }
+
+    lowest_column_ = constants::max_column();
+    highest_column_ = constants::min_column();
+
+    for (const auto &row : rows_)
+    {
+        lowest_column_ = std::min(lowest_column_, row.second.front()->column_);
+        highest_column_ = std::max(highest_column_, row.second.back()->column_);
+    }
+
+    columns_stale_ = false;
+}
+
+void cell_store::release(cell_impl *cell)
+{
+    cell->release_extras();
+    *cell = cell_impl();
+    free_.push_back(cell);
+    --size_;
+}
+
+} // namespace detail
+} // namespace xlnt
@@ -0,0 +1,322 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <xlnt/cell/index_types.hpp>
+#include <detail/implementations/cell_impl.hpp>
+
+namespace xlnt {
+namespace detail {
+
+/// <summary>
+/// Row-major storage for the cells of a worksheet.
+/// Rows are kept in ascending order and each row holds its cells sorted by column,
+/// so lookups are a row search followed by a binary search and traversal visits
+/// cells in sheet order. The cells themselves live in chunks owned by the store
+/// and never move, so cell_impl pointers held by xlnt::cell stay valid until
+/// that cell is erased.
+/// </summary>
+class cell_store
+{
+public:
+    /// <summary>
+    /// The cells of a single row, ordered by column.
+    /// </summary>
+    using row_cells = std::vector<cell_impl *>;
+
+    using row_map = std::map<row_t, row_cells>;
+
+    /// <summary>
+    /// Forward iterator over every cell in row-major order.
+    /// </summary>
+    template <typename RowIterator, typename Value>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+
+        basic_iterator() = default;
+
+        basic_iterator(RowIterator row, std::size_t index)
+            : row_(row), index_(index)
+        {
+        }
+
+        template <typename OtherRowIterator, typename OtherValue>
+        basic_iterator(const basic_iterator<OtherRowIterator, OtherValue> &other)
+            : row_(other.row_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *row_->second[index_];
+        }
+
+        pointer operator->() const
+        {
+            return row_->second[index_];
+        }
+
+        basic_iterator &operator++()
+        {
+            if (++index_ == row_->second.size())
+            {
+                ++row_;
+                index_ = 0;
+            }
+
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            auto old = *this;
+            ++*this;
+
+            return old;
+        }
+
+        bool operator==(const basic_iterator &other) const
+        {
+            return row_ == other.row_ && index_ == other.index_;
+        }
+
+        bool operator!=(const basic_iterator &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        friend class cell_store;
+
+        template <typename OtherRowIterator, typename OtherValue>
+        friend class basic_iterator;
+
+        RowIterator row_;
+        std::size_t index_ = 0;
+    };
+
+    using iterator = basic_iterator<row_map::iterator, cell_impl>;
+    using const_iterator = basic_iterator<row_map::const_iterator, const cell_impl>;
+
+    cell_store();
+    cell_store(const cell_store &other);
+    cell_store(cell_store &&other);
+    ~cell_store();
+
+    cell_store &operator=(const cell_store &other);
+    cell_store &operator=(cell_store &&other);
+
+    /// <summary>
+    /// Returns the cell at the given position or nullptr if it doesn't exist.
+    /// </summary>
+    cell_impl *find(column_t column, row_t row) const;
+
+    /// <summary>
+    /// Returns the cell at the given position, creating an empty cell there
+    /// if one didn't exist. The second member of the result is true if the cell
+    /// was created by this call.
+    /// </summary>
+    std::pair<cell_impl *, bool> emplace(column_t column, row_t row);
+
+    /// <summary>
+    /// Removes the cell at the given position. Returns true if a cell was removed.
+    /// </summary>
+    bool erase(column_t column, row_t row);
+
+    /// <summary>
+    /// Removes every cell in the given row.
+    /// </summary>
+    void erase_row(row_t row);
+
+    /// <summary>
+    /// Removes every cell for which predicate returns true, compacting each
+    /// row in a single pass. The predicate may take a copy of a cell it returns
+    /// true for, in which case it should set extras_ to zero so that the side
+    /// table entry isn't released along with the original.
+    /// </summary>
+    template <typename Predicate>
+    void erase_if(Predicate predicate)
+    {
+        auto row_iter = rows_.begin();
+
+        while (row_iter != rows_.end())
+        {
+            auto &cells = row_iter->second;
+            auto new_end = std::remove_if(cells.begin(), cells.end(), [&](cell_impl *cell) {
+                if (!predicate(*cell)) return false;
+                release(cell);
+                return true;
+            });
+            if (new_end != cells.end())
+            {
+                columns_stale_ = true;
+            }
+
+            cells.erase(new_end, cells.end());
+
+            if (cells.empty())
+            {
+                row_iter = erase_row_entry(row_iter);
+            }
+            else
+            {
+                ++row_iter;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Removes every cell and releases all cell storage. Side table entries are
+    /// left alone since they belong to the worksheet, which clears them itself.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Ensures that at least n more cells can be created without allocating.
+    /// </summary>
+    void reserve(std::size_t n);
+
+    /// <summary>
+    /// Returns the number of cells in the store.
+    /// </summary>
+    std::size_t size() const;
+
+    /// <summary>
+    /// Returns true if the store contains no cells.
+    /// </summary>
+    bool empty() const;
+
+    /// <summary>
+    /// Returns the rows of this store in ascending order. Only rows containing
+    /// at least one cell are present.
+    /// </summary>
+    const row_map &rows() const;
+
+    /// <summary>
+    /// Returns the lowest row containing a cell. The store must not be empty.
+    /// </summary>
+    row_t lowest_row() const;
+
+    /// <summary>
+    /// Returns the highest row containing a cell. The store must not be empty.
+    /// </summary>
+    row_t highest_row() const;
+
+    /// <summary>
+    /// Returns the lowest column containing a cell. The store must not be empty.
+    /// </summary>
+    column_t lowest_column() const;
+
+    /// <summary>
+    /// Returns the highest column containing a cell. The store must not be empty.
+    /// </summary>
+    column_t highest_column() const;
+
+    /// <summary>
+    /// Returns the cells of the given row in column order or nullptr if the
+    /// row contains no cells.
+    /// </summary>
+    const row_cells *row(row_t row) const;
+
+    /// <summary>
+    /// Returns the first cell in row whose column is at least column or nullptr
+    /// if there is no such cell.
+    /// </summary>
+    cell_impl *first_in_row(row_t row, column_t column) const;
+
+    /// <summary>
+    /// Returns the last cell in row whose column is at most column or nullptr
+    /// if there is no such cell.
+    /// </summary>
+    cell_impl *last_in_row(row_t row, column_t column) const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool operator==(const cell_store &other) const;
+    bool operator!=(const cell_store &other) const;
+
+private:
+    row_map::iterator find_row(row_t row) const;
+    row_map::iterator erase_row_entry(row_map::iterator row);
+
+    cell_impl *allocate();
+    void release(cell_impl *cell);
+    void release_column(column_t column);
+    void refresh_columns() const;
+
+    /// <summary>
+    /// Rows with at least one cell, each holding its cells sorted by column.
+    /// </summary>
+    mutable row_map rows_;
+
+    /// <summary>
+    /// The most recently used row. Access to a sheet is usually row-by-row,
+    /// so this avoids a tree search for consecutive cells of the same row.
+    /// </summary>
+    mutable row_map::iterator last_row_;
+
+    /// <summary>
+    /// Backing storage for the cells. Chunks grow geometrically and are only
+    /// released on clear() or destruction.
+    /// </summary>
+    std::vector<std::unique_ptr<cell_impl[]>> chunks_;
+    std::size_t chunk_capacity_ = 0;
+    std::size_t chunk_used_ = 0;
+
+    /// <summary>
+    /// Erased cells available for reuse.
+    /// </summary>
+    std::vector<cell_impl *> free_;
+
+    std::size_t size_ = 0;
+
+    /// <summary>
+    /// Column bounds of the stored cells. These are widened as cells are added
+    /// and only recomputed, by looking at the ends of each row, after a cell on
+    /// one of the edges has been removed. Row bounds come straight from rows_.
+    /// </summary>
+    mutable column_t lowest_column_;
+    mutable column_t highest_column_;
+    mutable bool columns_stale_ = false;
+};
+
+} // namespace detail
+} // namespace xlnt
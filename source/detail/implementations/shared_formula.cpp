@@ -0,0 +1,345 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <detail/implementations/shared_formula.hpp>
+
+namespace {
+
+// the largest row and column a spreadsheet can have, beyond which
+// something that looks like a reference is a name
+const std::int64_t last_row = 1048576;
+const std::int64_t last_column = 16384;
+
+bool is_letter(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// characters that can appear in a reference, name or number
+bool is_token_char(char c)
+{
+    return is_letter(c) || is_digit(c) || c == '_' || c == '.' || c == '$' || c == '\\'
+        || static_cast<unsigned char>(c) >= 0x80;
+}
+
+/// <summary>
+/// One half of a reference, a column or a row with an optional $.
+/// </summary>
+struct reference_part
+{
+    bool absolute = false;
+    std::int64_t index = 0;
+};
+
+// parses "$?[A-Za-z]{1,3}" spanning all of [first, last)
+bool parse_column(const char *first, const char *last, reference_part &part)
+{
+    part.absolute = first != last && *first == '$';
+    first += part.absolute ? 1 : 0;
+
+    if (last - first < 1 || last - first > 3)
+    {
+        return false;
+    }
+
+    part.index = 0;
+
+    for (; first != last; ++first)
+    {
+        if (!is_letter(*first))
+        {
+            return false;
+        }
+
+        part.index = part.index * 26 + ((*first & ~0x20) - 'A' + 1);
+    }
+
+    return part.index <= last_column;
+}
+
+// parses "$?[0-9]+" spanning all of [first, last)
+bool parse_row(const char *first, const char *last, reference_part &part)
+{
+    part.absolute = first != last && *first == '$';
+    first += part.absolute ? 1 : 0;
+
+    if (first == last || last - first > 7)
+    {
+        return false;
+    }
+
+    part.index = 0;
+
+    for (; first != last; ++first)
+    {
+        if (!is_digit(*first))
+        {
+            return false;
+        }
+
+        part.index = part.index * 10 + (*first - '0');
+    }
+
+    return part.index >= 1 && part.index <= last_row;
+}
+
+// parses a column followed by a row spanning all of [first, last)
+bool parse_cell(const char *first, const char *last, reference_part &column, reference_part &row)
+{
+    auto split = first + (first != last && *first == '$' ? 1 : 0);
+
+    while (split != last && is_letter(*split))
+    {
+        ++split;
+    }
+
+    return parse_column(first, split, column) && parse_row(split, last, row);
+}
+
+// moves part by offset unless it's absolute, returning false if it leaves the sheet
+bool shift(reference_part &part, std::int64_t offset, std::int64_t limit)
+{
+    if (!part.absolute)
+    {
+        part.index += offset;
+    }
+
+    return part.index >= 1 && part.index <= limit;
+}
+
+void append_column(std::string &out, const reference_part &column)
+{
+    if (column.absolute)
+    {
+        out.push_back('$');
+    }
+
+    char letters[3];
+    auto count = 0;
+
+    for (auto index = column.index; index > 0; index = (index - 1) / 26)
+    {
+        letters[count++] = static_cast<char>('A' + (index - 1) % 26);
+    }
+
+    while (count > 0)
+    {
+        out.push_back(letters[--count]);
+    }
+}
+
+void append_row(std::string &out, const reference_part &row)
+{
+    if (row.absolute)
+    {
+        out.push_back('$');
+    }
+
+    out.append(std::to_string(row.index));
+}
+
+// copies the quoted text starting at formula[i], in which the quote is
+// escaped by doubling it, and returns the index just past it
+std::size_t copy_quoted(const std::string &formula, std::size_t i, std::string &out)
+{
+    const auto quote = formula[i];
+    auto end = i + 1;
+
+    while (end < formula.size())
+    {
+        if (formula[end++] == quote)
+        {
+            if (end < formula.size() && formula[end] == quote)
+            {
+                ++end;
+                continue;
+            }
+
+            break;
+        }
+    }
+
+    out.append(formula, i, end - i);
+
+    return end;
+}
+
+// copies the bracketed text starting at formula[i], such as a table's
+// structured reference, and returns the index just past it
+std::size_t copy_bracketed(const std::string &formula, std::size_t i, std::string &out)
+{
+    auto depth = 0;
+    auto end = i;
+
+    do
+    {
+        if (formula[end] == '[')
+        {
+            ++depth;
+        }
+        else if (formula[end] == ']')
+        {
+            --depth;
+        }
+
+        ++end;
+    } while (depth > 0 && end < formula.size());
+
+    out.append(formula, i, end - i);
+
+    return end;
+}
+
+} // namespace
+
+namespace xlnt {
+namespace detail {
+
+std::string shift_formula(const std::string &formula, std::int64_t rows, std::int64_t columns)
+{
+    std::string result;
+    result.reserve(formula.size());
+
+    const auto data = formula.data();
+    auto i = std::size_t(0);
+
+    auto token_end = [&](std::size_t start) {
+        while (start < formula.size() && is_token_char(formula[start]))
+        {
+            ++start;
+        }
+
+        return start;
+    };
+
+    while (i < formula.size())
+    {
+        const auto c = formula[i];
+
+        if (c == '"' || c == '\'')
+        {
+            i = copy_quoted(formula, i, result);
+            continue;
+        }
+
+        if (c == '[')
+        {
+            i = copy_bracketed(formula, i, result);
+            continue;
+        }
+
+        if (!is_token_char(c))
+        {
+            result.push_back(c);
+            ++i;
+            continue;
+        }
+
+        const auto end = token_end(i);
+        const auto next = end < formula.size() ? formula[end] : '\0';
+
+        // functions and sheet names
+        if (next == '(' || next == '!')
+        {
+            result.append(formula, i, end - i);
+            i = end;
+            continue;
+        }
+
+        reference_part column, row;
+
+        if (parse_cell(data + i, data + end, column, row))
+        {
+            if (shift(column, columns, last_column) && shift(row, rows, last_row))
+            {
+                append_column(result, column);
+                append_row(result, row);
+            }
+            else
+            {
+                result.append("#REF!");
+            }
+
+            i = end;
+            continue;
+        }
+
+        // whole columns (A:C) and whole rows (1:3)
+        if (next == ':')
+        {
+            const auto second_end = token_end(end + 1);
+            reference_part second;
+
+            if (parse_column(data + i, data + end, column)
+                && parse_column(data + end + 1, data + second_end, second))
+            {
+                if (shift(column, columns, last_column) && shift(second, columns, last_column))
+                {
+                    append_column(result, column);
+                    result.push_back(':');
+                    append_column(result, second);
+                }
+                else
+                {
+                    result.append("#REF!");
+                }
+
+                i = second_end;
+                continue;
+            }
+
+            if (parse_row(data + i, data + end, row)
+                && parse_row(data + end + 1, data + second_end, second))
+            {
+                if (shift(row, rows, last_row) && shift(second, rows, last_row))
+                {
+                    append_row(result, row);
+                    result.push_back(':');
+                    append_row(result, second);
+                }
+                else
+                {
+                    result.append("#REF!");
+                }
+
+                i = second_end;
+                continue;
+            }
+        }
+
+        // names, numbers and constants
+        result.append(formula, i, end - i);
+        i = end;
+    }
+
+    return result;
+}
+
+} // namespace detail
+} // namespace xlnt
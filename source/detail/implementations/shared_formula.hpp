@@ -0,0 +1,70 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <xlnt/xlnt_config.hpp>
+#include <xlnt/cell/index_types.hpp>
+#include <xlnt/worksheet/range_reference.hpp>
+
+namespace xlnt {
+namespace detail {
+
+/// <summary>
+/// A formula stored once for a range of cells, as written in a <f t="shared">
+/// element. Each cell in the group uses the formula with its relative references
+/// moved by the cell's distance from the cell the formula was written for.
+/// </summary>
+struct shared_formula
+{
+    /// <summary>
+    /// The cell the formula text belongs to.
+    /// </summary>
+    column_t::index_t column = 1;
+    row_t row = 1;
+
+    /// <summary>
+    /// The formula of that cell, without a leading '='.
+    /// </summary>
+    std::string formula;
+
+    /// <summary>
+    /// The range covering every cell in the group, as given by the ref attribute.
+    /// </summary>
+    range_reference range;
+};
+
+/// <summary>
+/// Returns formula with each relative row and column of its A1-style references
+/// moved by rows and columns, as when the formula is copied that far. Absolute
+/// ($) parts, references into other workbooks' tables, names, functions and
+/// text are left alone. A reference moved off the sheet becomes #REF!.
+/// </summary>
+XLNT_API std::string shift_formula(const std::string &formula, std::int64_t rows, std::int64_t columns);
+
+} // namespace detail
+} // namespace xlnt
@@ -0,0 +1,133 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <xlnt/cell/rich_text.hpp>
+
+namespace xlnt {
+namespace detail {
+
+/// <summary>
+/// The shared strings of a workbook. Each string is stored once, in index order,
+/// and a hash index maps string hashes to positions so that adding a string and
+/// reading one by index are both constant time.
+/// </summary>
+class shared_string_table
+{
+public:
+    /// <summary>
+    /// Returns the index of the first string equal to text or size() if there isn't one.
+    /// </summary>
+    std::size_t find(const rich_text &text) const
+    {
+        return find(text, rich_text_hash()(text));
+    }
+
+    /// <summary>
+    /// Appends text and returns its index. Unless allow_duplicates is true, the index
+    /// of an existing equal string is returned instead.
+    /// </summary>
+    std::size_t add(const rich_text &text, bool allow_duplicates)
+    {
+        const auto hash = rich_text_hash()(text);
+        const auto existing = find(text, hash);
+
+        if (existing != strings_.size() && !allow_duplicates)
+        {
+            return existing;
+        }
+
+        // only the first of several equal strings is indexed so that find
+        // keeps returning it
+        if (existing == strings_.size())
+        {
+            positions_.emplace(hash, strings_.size());
+        }
+
+        strings_.push_back(text);
+
+        return strings_.size() - 1;
+    }
+
+    const rich_text &operator[](std::size_t index) const
+    {
+        return strings_[index];
+    }
+
+    std::size_t size() const
+    {
+        return strings_.size();
+    }
+
+    /// <summary>
+    /// Returns every string in index order.
+    /// </summary>
+    const std::vector<rich_text> &strings() const
+    {
+        return strings_;
+    }
+
+    void reserve(std::size_t n)
+    {
+        strings_.reserve(n);
+        positions_.reserve(n);
+    }
+
+    void clear()
+    {
+        strings_.clear();
+        positions_.clear();
+    }
+
+    bool operator==(const shared_string_table &other) const
+    {
+        return strings_ == other.strings_;
+    }
+
+private:
+    std::size_t find(const rich_text &text, std::size_t hash) const
+    {
+        auto candidates = positions_.equal_range(hash);
+
+        for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+        {
+            if (strings_[candidate->second] == text)
+            {
+                return candidate->second;
+            }
+        }
+
+        return strings_.size();
+    }
+
+    std::vector<rich_text> strings_;
+    std::unordered_multimap<std::size_t, std::size_t> positions_;
+};
+
+} // namespace detail
+} // namespace xlnt
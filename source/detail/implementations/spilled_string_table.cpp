@@ -0,0 +1,214 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#include <limits>
+
+#include <xlnt/utils/exceptions.hpp>
+#include <detail/implementations/spilled_string_table.hpp>
+
+namespace {
+
+// strings are written to the file in blocks of about this many bytes
+const std::size_t block_size = 64 * 1024;
+
+const std::size_t cache_slots = 4096;
+const std::size_t longest_cached = 128;
+
+const auto no_index = std::numeric_limits<std::size_t>::max();
+
+} // namespace
+
+namespace xlnt {
+namespace detail {
+
+spilled_string_table::spilled_string_table()
+    : file_(std::tmpfile()),
+      slots_(1024, 0),
+      cache_(cache_slots, std::make_pair(no_index, std::string()))
+{
+    if (file_ == nullptr)
+    {
+        throw xlnt::exception("unable to create a temporary file for shared strings");
+    }
+}
+
+spilled_string_table::~spilled_string_table()
+{
+    std::fclose(file_);
+}
+
+std::size_t spilled_string_table::add(const std::string &text)
+{
+    const auto hash = std::hash<std::string>()(text);
+    const auto mask = slots_.size() - 1;
+    auto slot = hash & mask;
+
+    while (slots_[slot] != 0)
+    {
+        const auto index = std::size_t(slots_[slot] - 1);
+        const auto &existing = entries_[index];
+
+        if (existing.hash == hash && existing.size == text.size() && equals(index, text))
+        {
+            return index;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    const auto index = entries_.size();
+    entries_.push_back({flushed_ + buffer_.size(), static_cast<std::uint32_t>(text.size()), hash});
+    slots_[slot] = static_cast<std::uint32_t>(index + 1);
+    buffer_.append(text);
+
+    if (text.size() <= longest_cached)
+    {
+        cache_[index % cache_slots] = std::make_pair(index, text);
+    }
+
+    if (buffer_.size() >= block_size)
+    {
+        flush();
+    }
+
+    // at most half full so that probe sequences stay short
+    if (entries_.size() * 2 > slots_.size())
+    {
+        grow();
+    }
+
+    return index;
+}
+
+std::size_t spilled_string_table::size() const
+{
+    return entries_.size();
+}
+
+void spilled_string_table::for_each(const std::function<void(const std::string &)> &visit)
+{
+    flush();
+    seek(0);
+
+    // the strings are stored in index order so the file is read straight through
+    for (const auto &stored : entries_)
+    {
+        scratch_.resize(stored.size);
+
+        if (stored.size > 0 && std::fread(&scratch_[0], 1, stored.size, file_) != stored.size)
+        {
+            throw xlnt::exception("unable to read shared strings from a temporary file");
+        }
+
+        visit(scratch_);
+    }
+}
+
+bool spilled_string_table::equals(std::size_t index, const std::string &text)
+{
+    auto &cached = cache_[index % cache_slots];
+
+    if (cached.first == index)
+    {
+        return cached.second == text;
+    }
+
+    const auto &stored = entries_[index];
+
+    if (stored.offset >= flushed_)
+    {
+        return buffer_.compare(static_cast<std::size_t>(stored.offset - flushed_), stored.size, text) == 0;
+    }
+
+    read(index);
+
+    if (stored.size <= longest_cached)
+    {
+        cached.first = index;
+        cached.second = scratch_;
+    }
+
+    return scratch_ == text;
+}
+
+void spilled_string_table::read(std::size_t index)
+{
+    const auto &stored = entries_[index];
+    scratch_.resize(stored.size);
+    seek(stored.offset);
+
+    if (stored.size > 0 && std::fread(&scratch_[0], 1, stored.size, file_) != stored.size)
+    {
+        throw xlnt::exception("unable to read shared strings from a temporary file");
+    }
+}
+
+void spilled_string_table::flush()
+{
+    if (buffer_.empty()) return;
+
+    // a stream that was read from must be positioned before it can be written to
+    if (std::fseek(file_, 0, SEEK_END) != 0
+        || std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size())
+    {
+        throw xlnt::exception("unable to write shared strings to a temporary file");
+    }
+
+    flushed_ += buffer_.size();
+    buffer_.clear();
+}
+
+void spilled_string_table::seek(std::uint64_t offset)
+{
+#ifdef _WIN32
+    const auto result = _fseeki64(file_, static_cast<__int64>(offset), SEEK_SET);
+#else
+    const auto result = fseeko(file_, static_cast<off_t>(offset), SEEK_SET);
+#endif
+
+    if (result != 0)
+    {
+        throw xlnt::exception("unable to read shared strings from a temporary file");
+    }
+}
+
+void spilled_string_table::grow()
+{
+    slots_.assign(slots_.size() * 2, 0);
+    const auto mask = slots_.size() - 1;
+
+    for (std::size_t index = 0; index < entries_.size(); ++index)
+    {
+        auto slot = entries_[index].hash & mask;
+
+        while (slots_[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        slots_[slot] = static_cast<std::uint32_t>(index + 1);
+    }
+}
+
+} // namespace detail
+} // namespace xlnt
@@ -0,0 +1,125 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <xlnt/xlnt_config.hpp>
+
+namespace xlnt {
+namespace detail {
+
+/// <summary>
+/// Shared strings kept in a temporary file rather than in memory, for workbooks
+/// written by streaming_workbook_writer. Each string is stored once. Memory use
+/// is a few dozen bytes per distinct string for the hash index, plus a cache
+/// of recently used short strings that saves rereading them from the file.
+/// </summary>
+class XLNT_API spilled_string_table
+{
+public:
+    /// <summary>
+    /// Creates an empty table backed by a new temporary file, which is removed
+    /// when the table is destroyed.
+    /// </summary>
+    spilled_string_table();
+
+    ~spilled_string_table();
+
+    spilled_string_table(const spilled_string_table &) = delete;
+    spilled_string_table &operator=(const spilled_string_table &) = delete;
+
+    /// <summary>
+    /// Returns the index of text, appending it if the table doesn't have it yet.
+    /// </summary>
+    std::size_t add(const std::string &text);
+
+    std::size_t size() const;
+
+    /// <summary>
+    /// Calls visit with each string in index order.
+    /// </summary>
+    void for_each(const std::function<void(const std::string &)> &visit);
+
+private:
+    struct entry
+    {
+        std::uint64_t offset;
+        std::uint32_t size;
+        std::size_t hash;
+    };
+
+    /// <summary>
+    /// Returns true if the string stored at index is text.
+    /// </summary>
+    bool equals(std::size_t index, const std::string &text);
+
+    /// <summary>
+    /// Reads the string stored at index into scratch_.
+    /// </summary>
+    void read(std::size_t index);
+
+    /// <summary>
+    /// Appends the buffered strings to the file.
+    /// </summary>
+    void flush();
+
+    void seek(std::uint64_t offset);
+
+    /// <summary>
+    /// Doubles the hash index and reinserts every string.
+    /// </summary>
+    void grow();
+
+    std::FILE *file_;
+
+    /// <summary>
+    /// Strings not yet written to the file, which starts at offset flushed_.
+    /// </summary>
+    std::string buffer_;
+    std::uint64_t flushed_ = 0;
+
+    std::vector<entry> entries_;
+
+    /// <summary>
+    /// Open addressing hash index holding one plus an index into entries_, or zero.
+    /// </summary>
+    std::vector<std::uint32_t> slots_;
+
+    /// <summary>
+    /// Direct-mapped cache of short strings by index. Strings that are
+    /// repeated are usually repeated often, so most lookups are answered here.
+    /// </summary>
+    std::vector<std::pair<std::size_t, std::string>> cache_;
+
+    std::string scratch_;
+};
+
+} // namespace detail
+} // namespace xlnt
@@ -0,0 +1,172 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <xlnt/styles/alignment.hpp>
+#include <xlnt/styles/border.hpp>
+#include <xlnt/styles/fill.hpp>
+#include <xlnt/styles/font.hpp>
+#include <xlnt/styles/number_format.hpp>
+#include <xlnt/styles/protection.hpp>
+#include <detail/implementations/format_impl.hpp>
+
+namespace xlnt {
+namespace detail {
+
+// These hashes only look at a few cheap fields. Equal values always hash
+// equally and lookups compare candidates with operator==, so that is enough
+// to keep buckets small without mirroring every equality operator.
+
+inline void hash_combine(std::size_t &seed, std::size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+inline std::size_t style_hash(const alignment &value)
+{
+    std::size_t seed = 0;
+    hash_combine(seed, value.horizontal().is_set() ? static_cast<std::size_t>(value.horizontal().get()) + 1 : 0);
+    hash_combine(seed, value.vertical().is_set() ? static_cast<std::size_t>(value.vertical().get()) + 1 : 0);
+    hash_combine(seed, value.wrap() ? 1 : 0);
+    return seed;
+}
+
+inline std::size_t style_hash(const border &value)
+{
+    std::size_t seed = 0;
+
+    for (auto side : border::all_sides())
+    {
+        auto property = value.side(side);
+        hash_combine(seed, property.is_set() && property.get().style().is_set()
+            ? static_cast<std::size_t>(property.get().style().get()) + 2
+            : property.is_set() ? 1 : 0);
+    }
+
+    return seed;
+}
+
+inline std::size_t style_hash(const fill &value)
+{
+    return static_cast<std::size_t>(value.type());
+}
+
+inline std::size_t style_hash(const font &value)
+{
+    std::size_t seed = 0;
+    hash_combine(seed, value.has_name() ? std::hash<std::string>()(value.name()) : 0);
+    // + 0.0 so that -0.0 and 0.0, which compare equal, hash equally
+    hash_combine(seed, value.has_size() ? std::hash<double>()(value.size() + 0.0) : 0);
+    hash_combine(seed, value.bold() ? 1 : 0);
+    hash_combine(seed, value.italic() ? 1 : 0);
+    return seed;
+}
+
+inline std::size_t style_hash(const number_format &value)
+{
+    return std::hash<std::string>()(value.format_string());
+}
+
+inline std::size_t style_hash(const protection &value)
+{
+    return (value.locked() ? 1 : 0) | (value.hidden() ? 2 : 0);
+}
+
+/// <summary>
+/// Only the component ids take part, since the remaining fields of a format
+/// (style name, pivot button, quote prefix) can be changed in place.
+/// </summary>
+inline std::size_t style_hash(const format_impl &value)
+{
+    std::size_t seed = 0;
+    hash_combine(seed, value.alignment_id.is_set() ? value.alignment_id.get() + 1 : 0);
+    hash_combine(seed, value.border_id.is_set() ? value.border_id.get() + 1 : 0);
+    hash_combine(seed, value.fill_id.is_set() ? value.fill_id.get() + 1 : 0);
+    hash_combine(seed, value.font_id.is_set() ? value.font_id.get() + 1 : 0);
+    hash_combine(seed, value.number_format_id.is_set() ? value.number_format_id.get() + 1 : 0);
+    hash_combine(seed, value.protection_id.is_set() ? value.protection_id.get() + 1 : 0);
+    return seed;
+}
+
+/// <summary>
+/// Hash index over one of the stylesheet's component vectors (fonts, fills, ...)
+/// mapping values to their positions. The vectors are appended to directly
+/// while reading a stylesheet, so new elements are indexed lazily on the next
+/// lookup. Anything that erases or reorders elements must call reset().
+/// </summary>
+template <typename T>
+class style_lookup
+{
+public:
+    /// <summary>
+    /// Returns the position of item in container, appending it if it isn't there.
+    /// </summary>
+    std::size_t find_or_add(std::vector<T> &container, const T &item)
+    {
+        if (container.size() < indexed_)
+        {
+            reset();
+        }
+
+        for (; indexed_ < container.size(); ++indexed_)
+        {
+            positions_.emplace(style_hash(container[indexed_]), indexed_);
+        }
+
+        const auto hash = style_hash(item);
+        auto candidates = positions_.equal_range(hash);
+
+        for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+        {
+            if (container[candidate->second] == item)
+            {
+                return candidate->second;
+            }
+        }
+
+        container.push_back(item);
+        positions_.emplace(hash, indexed_);
+
+        return indexed_++;
+    }
+
+    void reset()
+    {
+        positions_.clear();
+        indexed_ = 0;
+    }
+
+private:
+    std::unordered_multimap<std::size_t, std::size_t> positions_;
+    std::size_t indexed_ = 0;
+};
+
+} // namespace detail
+} // namespace xlnt
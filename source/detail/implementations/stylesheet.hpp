@@ -25,11 +25,13 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <detail/implementations/conditional_format_impl.hpp>
 #include <detail/implementations/format_impl.hpp>
 #include <detail/implementations/style_impl.hpp>
+#include <detail/implementations/style_lookup.hpp>
 #include <xlnt/cell/cell.hpp>
 #include <xlnt/styles/conditional_format.hpp>
 #include <xlnt/styles/format.hpp>
@@ -46,6 +48,7 @@ struct stylesheet
 {
     class format create_format(bool default_format)
     {
+        const auto index_valid = format_index_valid();
 		format_impls.push_back(format_impl());
 		auto &impl = format_impls.back();
 
@@ -53,16 +56,56 @@ struct stylesheet
 		impl.id = format_impls.size() - 1;
 
         impl.references = default_format ? 1 : 0;
+
+        if (index_valid)
+        {
+            format_index.push_back(&impl);
+            format_lookup.emplace(style_hash(impl), &impl);
+        }
         
         return xlnt::format(&impl);
     }
 
     class xlnt::format format(std::size_t index)
     {
-        auto iter = format_impls.begin();
-        std::advance(iter, static_cast<std::list<format_impl>::difference_type>(index));
+        return xlnt::format(format_by_id(index));
+    }
 
-        return xlnt::format(&*iter);
+    format_impl *format_by_id(std::size_t index)
+    {
+        refresh_format_index();
+
+        if (index >= format_index.size())
+        {
+            throw invalid_parameter();
+        }
+
+        return format_index[index];
+    }
+
+    bool format_index_valid() const
+    {
+        // the index is copied along with the stylesheet but points into the
+        // original's list, and formats appended to the list directly (e.g. while
+        // reading styles) aren't in it yet
+        return format_index_owner == this && format_index.size() == format_impls.size();
+    }
+
+    void refresh_format_index()
+    {
+        if (format_index_valid()) return;
+
+        format_index.clear();
+        format_index.reserve(format_impls.size());
+        format_lookup.clear();
+
+        for (auto &impl : format_impls)
+        {
+            format_index.push_back(&impl);
+            format_lookup.emplace(style_hash(impl), &impl);
+        }
+
+        format_index_owner = this;
     }
 
     class style create_style(const std::string &name)
@@ -172,26 +215,26 @@ struct stylesheet
 		return id;
 	}
     
-    template<typename T, typename C>
-    std::size_t find_or_add(C &container, const T &item)
+    template<typename T>
+    std::size_t find_or_add(std::vector<T> &container, const T &item)
     {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsign-conversion"
-        auto iter = std::find(container.begin(), container.end(), item);
-        if (iter != container.end())
-        {
-            return std::size_t(iter - container.begin());
-        }
-        iter = container.emplace(container.end(), item);
-        return std::size_t(iter - container.begin());
-#pragma GCC diagnostic pop
+        return lookup(container).find_or_add(container, item);
     }
+
+    style_lookup<alignment> &lookup(const std::vector<alignment> &) { return alignment_lookup; }
+    style_lookup<border> &lookup(const std::vector<border> &) { return border_lookup; }
+    style_lookup<fill> &lookup(const std::vector<fill> &) { return fill_lookup; }
+    style_lookup<font> &lookup(const std::vector<font> &) { return font_lookup; }
+    style_lookup<number_format> &lookup(const std::vector<number_format> &) { return number_format_lookup; }
+    style_lookup<protection> &lookup(const std::vector<protection> &) { return protection_lookup; }
     
     template<typename T>
     std::unordered_map<std::size_t, std::size_t> garbage_collect(
         const std::unordered_map<std::size_t, std::size_t> &reference_counts,
         std::vector<T> &container)
     {
+        lookup(container).reset();
+
         std::unordered_map<std::size_t, std::size_t> id_map;
         std::size_t unreferenced = 0;
         const auto original_size = container.size();
@@ -210,9 +253,22 @@ struct stylesheet
         return id_map;
     }
     
+    /// <summary>
+    /// Collects garbage if a format has been replaced since the last collection.
+    /// </summary>
+    void garbage_collect_if_pending()
+    {
+        if (garbage_collection_pending)
+        {
+            garbage_collect();
+        }
+    }
+
     void garbage_collect()
     {
         if (!garbage_collection_enabled) return;
+
+        garbage_collection_pending = false;
         
         auto format_iter = format_impls.begin();
         while (format_iter != format_impls.end())
@@ -228,6 +284,9 @@ struct stylesheet
                 format_iter = format_impls.erase(format_iter);
             }
         }
+
+        format_index.clear();
+        format_lookup.clear();
         
         std::size_t new_id = 0;
 
@@ -379,43 +438,104 @@ struct stylesheet
     format_impl *find_or_create(format_impl &pattern)
     {
         pattern.references = 0;
-        std::size_t id = 0;
-        auto iter = format_impls.begin();
-        while (iter != format_impls.end() && !(*iter == pattern))
+        refresh_format_index();
+
+        // if there are duplicates, use the first like a linear search would
+        const auto hash = style_hash(pattern);
+        format_impl *result = nullptr;
+        auto candidates = format_lookup.equal_range(hash);
+
+        for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
         {
-            ++id;
-            ++iter;
+            if (*candidate->second == pattern && (result == nullptr || candidate->second->id < result->id))
+            {
+                result = candidate->second;
+            }
         }
-        if (iter == format_impls.end())
+
+        if (result == nullptr)
         {
-            iter = format_impls.emplace(format_impls.end(), pattern);
+            format_impls.push_back(pattern);
+            result = &format_impls.back();
+            result->id = format_impls.size() - 1;
+            format_index.push_back(result);
+            format_lookup.emplace(hash, result);
         }
-        auto &result = *iter;
 
-        result.parent = this;
-        result.id = id;
-        result.references++;
+        result->parent = this;
+        result->references++;
         
-        if (id != pattern.id)
+        if (result->id != pattern.id)
         {
-            iter = format_impls.begin();
-            std::advance(iter, static_cast<std::list<format_impl>::difference_type>(pattern.id));
-            iter->references -= iter->references > 0 ? 1 : 0;
-            garbage_collect();
+            auto previous = format_by_id(pattern.id);
+            previous->references -= previous->references > 0 ? 1 : 0;
+
+            // collecting here would make restyling a sheet quadratic, so unused
+            // formats are left in place (and reused by later lookups) until save
+            garbage_collection_pending = true;
         }
 
-        return &result;
+        return result;
     }
 
-    format_impl *find_or_create_with(format_impl *pattern, const std::string &style_name)
+    /// <summary>
+    /// Removes the entry for impl from format_lookup.
+    /// </summary>
+    void unindex_format(format_impl *impl)
+    {
+        auto candidates = format_lookup.equal_range(style_hash(*impl));
+
+        for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+        {
+            if (candidate->second == impl)
+            {
+                format_lookup.erase(candidate);
+                break;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Returns the format equal to new_format, creating it if needed. If nothing
+    /// refers to pattern, it's updated in place to become the new format.
+    /// </summary>
+    format_impl *find_or_create_from(format_impl *pattern, format_impl &new_format)
     {
-        format_impl new_format = *pattern;
-        new_format.style = style_name;
         if (pattern->references == 0)
         {
+            if (format_index_valid())
+            {
+                unindex_format(pattern);
+                format_lookup.emplace(style_hash(new_format), pattern);
+            }
+
             *pattern = new_format;
         }
-        return find_or_create(new_format);
+
+        auto result = find_or_create(new_format);
+
+        // styling a cell that had no format goes through a fresh create_format(),
+        // which is left unused when an equal format already exists. it's the last
+        // format so it can be dropped now without renumbering anything.
+        if (result != pattern && pattern->references == 0 && pattern == &format_impls.back())
+        {
+            if (format_index_valid())
+            {
+                unindex_format(pattern);
+                format_index.pop_back();
+            }
+
+            format_impls.pop_back();
+        }
+
+        return result;
+    }
+
+    format_impl *find_or_create_with(format_impl *pattern, const std::string &style_name)
+    {
+        format_impl new_format = *pattern;
+        new_format.style = style_name;
+        return find_or_create_from(pattern, new_format);
     }
 
     format_impl *find_or_create_with(format_impl *pattern, const alignment &new_alignment, optional<bool> applied)
@@ -423,11 +543,7 @@ struct stylesheet
         format_impl new_format = *pattern;
         new_format.alignment_id = find_or_add(alignments, new_alignment);
         new_format.alignment_applied = applied;
-        if (pattern->references == 0)
-        {
-            *pattern = new_format;
-        }
-        return find_or_create(new_format);
+        return find_or_create_from(pattern, new_format);
     }
 
     format_impl *find_or_create_with(format_impl *pattern, const border &new_border, optional<bool> applied)
@@ -435,11 +551,7 @@ struct stylesheet
         format_impl new_format = *pattern;
         new_format.border_id = find_or_add(borders, new_border);
         new_format.border_applied = applied;
-        if (pattern->references == 0)
-        {
-            *pattern = new_format;
-        }
-        return find_or_create(new_format);
+        return find_or_create_from(pattern, new_format);
     }
     
     format_impl *find_or_create_with(format_impl *pattern, const fill &new_fill, optional<bool> applied)
@@ -447,11 +559,7 @@ struct stylesheet
         format_impl new_format = *pattern;
         new_format.fill_id = find_or_add(fills, new_fill);
         new_format.fill_applied = applied;
-        if (pattern->references == 0)
-        {
-            *pattern = new_format;
-        }
-        return find_or_create(new_format);
+        return find_or_create_from(pattern, new_format);
     }
     
     format_impl *find_or_create_with(format_impl *pattern, const font &new_font, optional<bool> applied)
@@ -459,11 +567,7 @@ struct stylesheet
         format_impl new_format = *pattern;
         new_format.font_id = find_or_add(fonts, new_font);
         new_format.font_applied = applied;
-        if (pattern->references == 0)
-        {
-            *pattern = new_format;
-        }
-        return find_or_create(new_format);
+        return find_or_create_from(pattern, new_format);
     }
     
     format_impl *find_or_create_with(format_impl *pattern, const number_format &new_number_format, optional<bool> applied)
@@ -475,11 +579,7 @@ struct stylesheet
         }
         new_format.number_format_id = new_number_format.id();
         new_format.number_format_applied = applied;
-        if (pattern->references == 0)
-        {
-            *pattern = new_format;
-        }
-        return find_or_create(new_format);
+        return find_or_create_from(pattern, new_format);
     }
     
     format_impl *find_or_create_with(format_impl *pattern, const protection &new_protection, optional<bool> applied)
@@ -487,11 +587,7 @@ struct stylesheet
         format_impl new_format = *pattern;
         new_format.protection_id = find_or_add(protections, new_protection);
         new_format.protection_applied = applied;
-        if (pattern->references == 0)
-        {
-            *pattern = new_format;
-        }
-        return find_or_create(new_format);
+        return find_or_create_from(pattern, new_format);
     }
 
     std::size_t style_index(const std::string &name) const
@@ -504,6 +600,8 @@ struct stylesheet
     {
 		conditional_format_impls.clear();
         format_impls.clear();
+        format_index.clear();
+        format_lookup.clear();
         
         style_impls.clear();
         style_names.clear();
@@ -514,6 +612,13 @@ struct stylesheet
         fonts.clear();
         number_formats.clear();
         protections.clear();
+
+        alignment_lookup.reset();
+        border_lookup.reset();
+        fill_lookup.reset();
+        font_lookup.reset();
+        number_format_lookup.reset();
+        protection_lookup.reset();
         
         colors.clear();
     }
@@ -554,10 +659,27 @@ struct stylesheet
     }
     
     bool garbage_collection_enabled = true;
+
+    /// <summary>
+    /// True if formats may have become unreferenced since the last collection.
+    /// </summary>
+    bool garbage_collection_pending = false;
     bool known_fonts_enabled = false;
 
 	std::list<conditional_format_impl> conditional_format_impls;
     std::list<format_impl> format_impls;
+
+    /// <summary>
+    /// Pointers to the elements of format_impls in id order for constant time
+    /// lookup by index. Rebuilt by format_by_id whenever format_index_valid() is false.
+    /// </summary>
+    std::vector<format_impl *> format_index;
+    const stylesheet *format_index_owner = nullptr;
+
+    /// <summary>
+    /// Hash index over format_impls used to find existing formats, kept in step with format_index.
+    /// </summary>
+    std::unordered_multimap<std::size_t, format_impl *> format_lookup;
     std::unordered_map<std::string, style_impl> style_impls;
     std::vector<std::string> style_names;
     optional<std::string> default_slicer_style;
@@ -570,6 +692,13 @@ struct stylesheet
 	std::vector<protection> protections;
     
     std::vector<color> colors;
+
+    style_lookup<alignment> alignment_lookup;
+    style_lookup<border> border_lookup;
+    style_lookup<fill> fill_lookup;
+    style_lookup<font> font_lookup;
+    style_lookup<number_format> number_format_lookup;
+    style_lookup<protection> protection_lookup;
 };
 
 } // namespace detail
@@ -23,10 +23,12 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <detail/implementations/shared_string_table.hpp>
 #include <detail/implementations/stylesheet.hpp>
 #include <detail/implementations/worksheet_impl.hpp>
 #include <xlnt/packaging/ext_list.hpp>
@@ -34,6 +36,7 @@
 #include <xlnt/utils/datetime.hpp>
 #include <xlnt/utils/variant.hpp>
 #include <xlnt/workbook/calculation_properties.hpp>
+#include <xlnt/workbook/load_options.hpp>
 #include <xlnt/workbook/theme.hpp>
 #include <xlnt/workbook/workbook_view.hpp>
 #include <xlnt/worksheet/range.hpp>
@@ -43,6 +46,7 @@
 namespace xlnt {
 namespace detail {
 
+class izstream;
 struct worksheet_impl;
 
 struct workbook_impl
@@ -54,8 +58,7 @@ struct workbook_impl
     workbook_impl(const workbook_impl &other)
         : active_sheet_index_(other.active_sheet_index_),
           worksheets_(other.worksheets_),
-          shared_strings_ids_(other.shared_strings_ids_),
-          shared_strings_values_(other.shared_strings_values_),
+          shared_strings_(other.shared_strings_),
           stylesheet_(other.stylesheet_),
           manifest_(other.manifest_),
           theme_(other.theme_),
@@ -64,7 +67,9 @@ struct workbook_impl
           custom_properties_(other.custom_properties_),
           view_(other.view_),
           code_name_(other.code_name_),
-          file_version_(other.file_version_)
+          file_version_(other.file_version_),
+          deferred_archive_(other.deferred_archive_),
+          deferred_options_(other.deferred_options_)
     {
     }
 
@@ -73,8 +78,7 @@ struct workbook_impl
         active_sheet_index_ = other.active_sheet_index_;
         worksheets_.clear();
         std::copy(other.worksheets_.begin(), other.worksheets_.end(), back_inserter(worksheets_));
-        shared_strings_ids_ = other.shared_strings_ids_;
-        shared_strings_values_ = other.shared_strings_values_;
+        shared_strings_ = other.shared_strings_;
         theme_ = other.theme_;
         manifest_ = other.manifest_;
 
@@ -87,6 +91,9 @@ struct workbook_impl
         extended_properties_ = other.extended_properties_;
         custom_properties_ = other.custom_properties_;
 
+        deferred_archive_ = other.deferred_archive_;
+        deferred_options_ = other.deferred_options_;
+
         return *this;
     }
 
@@ -94,7 +101,7 @@ struct workbook_impl
     {
         return active_sheet_index_ == other.active_sheet_index_
             && worksheets_ == other.worksheets_
-            && shared_strings_ids_ == other.shared_strings_ids_
+            && shared_strings_ == other.shared_strings_
             && stylesheet_ == other.stylesheet_
             && base_date_ == other.base_date_
             && title_ == other.title_
@@ -117,8 +124,7 @@ struct workbook_impl
     optional<std::size_t> active_sheet_index_;
 
     std::list<worksheet_impl> worksheets_;
-    std::unordered_map<rich_text, std::size_t, rich_text_hash> shared_strings_ids_;
-    std::map<std::size_t, rich_text> shared_strings_values_;
+    shared_string_table shared_strings_;
 
     optional<stylesheet> stylesheet_;
 
@@ -159,6 +165,13 @@ struct workbook_impl
     optional<std::string> abs_path_;
     optional<std::size_t> arch_id_flags_;
     optional<ext_list> extensions_;
+
+    /// <summary>
+    /// The package deferred worksheets are read from and the options they are read
+    /// with. Released once every worksheet has been read.
+    /// </summary>
+    std::shared_ptr<izstream> deferred_archive_;
+    load_options deferred_options_;
 };
 
 } // namespace detail
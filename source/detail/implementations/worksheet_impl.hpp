@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -41,6 +42,8 @@
 #include <xlnt/worksheet/print_options.hpp>
 #include <xlnt/worksheet/sheet_pr.hpp>
 #include <detail/implementations/cell_impl.hpp>
+#include <detail/implementations/cell_store.hpp>
+#include <detail/implementations/shared_formula.hpp>
 
 namespace xlnt {
 
@@ -72,6 +75,10 @@ struct worksheet_impl
         column_properties_ = other.column_properties_;
         row_properties_ = other.row_properties_;
         cell_map_ = other.cell_map_;
+        cell_extras_ = other.cell_extras_;
+        hyperlinks_ = other.hyperlinks_;
+        formulae_ = other.formulae_;
+        shared_formulas_ = other.shared_formulas_;
         page_setup_ = other.page_setup_;
         auto_filter_ = other.auto_filter_;
         page_margins_ = other.page_margins_;
@@ -88,15 +95,36 @@ struct worksheet_impl
         extension_list_ = other.extension_list_;
         sheet_properties_ = other.sheet_properties_;
         print_options_ = other.print_options_;
+        deferred_ = other.deferred_;
 
         for (auto &cell : cell_map_)
         {
-            cell.second.parent_ = this;
+            cell.parent_ = this;
         }
     }
 
     workbook *parent_;
 
+    /// <summary>
+    /// Reclaims the space of released formula text once formulae_ is mostly
+    /// unused. Called whenever formula text is released, so that replacing
+    /// formulae one at a time, as the streaming reader and writer do, doesn't
+    /// grow the arena without bound.
+    /// </summary>
+    void compact_formulae()
+    {
+        if (!formulae_.fragmented()) return;
+
+        formulae_.compact([this](const std::function<void(string_arena::handle &)> &relocate) {
+            cell_extras_.for_each([&relocate](cell_extras &extras) {
+                if (extras.formula_.is_set())
+                {
+                    relocate(extras.formula_.get());
+                }
+            });
+        });
+    }
+
     bool operator==(const worksheet_impl& rhs) const
     {
         return id_ == rhs.id_
@@ -127,12 +155,32 @@ struct worksheet_impl
     std::size_t id_;
     std::string title_;
 
+    /// <summary>
+    /// True if the worksheet hasn't been read yet, see load_options::lazy_worksheets.
+    /// </summary>
+    bool deferred_ = false;
+
     sheet_format_properties format_properties_;
 
     std::unordered_map<column_t, column_properties> column_properties_;
     std::unordered_map<row_t, row_properties> row_properties_;
 
-    std::unordered_map<cell_reference, cell_impl> cell_map_;
+    cell_store cell_map_;
+
+    /// <summary>
+    /// Text, formulae, hyperlinks and comments of the cells in cell_map_, indexed
+    /// by cell_impl::extras_. Together with cell_map_ these form the arena that
+    /// holds a sheet's cells, which is released in bulk with the sheet.
+    /// </summary>
+    chunked_table<cell_extras> cell_extras_;
+    chunked_table<hyperlink_impl> hyperlinks_;
+    string_arena formulae_;
+
+    /// <summary>
+    /// Formulae read from <f t="shared"> elements, indexed by cell_impl::shared_formula_.
+    /// Each is stored once and expanded for the other cells of its group on request.
+    /// </summary>
+    std::vector<shared_formula> shared_formulas_;
 
     optional<page_setup> page_setup_;
     optional<range_reference> auto_filter_;
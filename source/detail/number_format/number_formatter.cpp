@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <limits>
 
 #include <xlnt/utils/exceptions.hpp>
 #include <detail/default_case.hpp>
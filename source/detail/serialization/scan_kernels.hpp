@@ -0,0 +1,189 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XLNT_SCAN_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace xlnt {
+namespace detail {
+
+// Searches used by sheet_data_scanner. Nearly every token in sheetData is
+// shorter than a vector register, so these are inlined into the scanner and
+// use SSE2, which every x86-64 processor has, rather than being dispatched
+// at runtime to wider instruction sets. Each has a scalar version, used for
+// the last few bytes of a range and on other architectures, that gives the
+// same result. Names are still read a byte at a time since they are mostly
+// one to three characters long, too short for a vector compare to pay off.
+
+/// <summary>
+/// Returns the first c in [begin, end) or end.
+/// </summary>
+inline const char *scalar_find_byte(const char *begin, const char *end, char c)
+{
+    while (begin != end && *begin != c)
+    {
+        ++begin;
+    }
+
+    return begin;
+}
+
+/// <summary>
+/// Returns the first character in [begin, end) that ends a run of plain
+/// character data, i.e. '<', '&' or '\r', or end.
+/// </summary>
+inline const char *scalar_find_text_break(const char *begin, const char *end)
+{
+    while (begin != end && *begin != '<' && *begin != '&' && *begin != '\r')
+    {
+        ++begin;
+    }
+
+    return begin;
+}
+
+/// <summary>
+/// Returns the end of the run of ASCII digits at the start of [begin, end).
+/// </summary>
+inline const char *scalar_skip_digits(const char *begin, const char *end)
+{
+    while (begin != end && *begin >= '0' && *begin <= '9')
+    {
+        ++begin;
+    }
+
+    return begin;
+}
+
+#ifdef XLNT_SCAN_SSE2
+
+/// <summary>
+/// Index of the lowest set bit of a non-zero movemask result.
+/// </summary>
+inline int lowest_set_bit(int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, static_cast<unsigned long>(mask));
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(static_cast<unsigned int>(mask));
+#endif
+}
+
+/// <summary>
+/// Applies match, which maps 16 bytes to a byte mask, to consecutive blocks of
+/// [begin, end) and returns the first matching position, leaving any last
+/// partial block to scalar.
+/// </summary>
+template <typename Match, typename Scalar>
+const char *find_block(const char *begin, const char *end, Match match, Scalar scalar)
+{
+    while (end - begin >= 16)
+    {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        const auto mask = _mm_movemask_epi8(match(block));
+
+        if (mask != 0)
+        {
+            return begin + lowest_set_bit(mask);
+        }
+
+        begin += 16;
+    }
+
+    return scalar(begin, end);
+}
+
+inline const char *find_byte(const char *begin, const char *end, char c)
+{
+    const auto needle = _mm_set1_epi8(c);
+
+    return find_block(
+        begin, end,
+        [needle](__m128i block) { return _mm_cmpeq_epi8(block, needle); },
+        [c](const char *b, const char *e) { return scalar_find_byte(b, e, c); });
+}
+
+inline const char *find_text_break(const char *begin, const char *end)
+{
+    const auto lt = _mm_set1_epi8('<');
+    const auto amp = _mm_set1_epi8('&');
+    const auto cr = _mm_set1_epi8('\r');
+
+    return find_block(
+        begin, end,
+        [=](__m128i block) {
+            return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, lt), _mm_cmpeq_epi8(block, amp)),
+                _mm_cmpeq_epi8(block, cr));
+        },
+        scalar_find_text_break);
+}
+
+inline const char *skip_digits(const char *begin, const char *end)
+{
+    // bytes below '0' wrap around to large values, so one unsigned
+    // comparison tells digits apart from everything else
+    const auto zero = _mm_set1_epi8('0');
+    const auto nine = _mm_set1_epi8(9);
+
+    return find_block(
+        begin, end,
+        [=](__m128i block) {
+            const auto offset = _mm_sub_epi8(block, zero);
+            const auto digit = _mm_cmpeq_epi8(_mm_min_epu8(offset, nine), offset);
+            return _mm_xor_si128(digit, _mm_set1_epi8(-1));
+        },
+        scalar_skip_digits);
+}
+
+#else
+
+inline const char *find_byte(const char *begin, const char *end, char c)
+{
+    return scalar_find_byte(begin, end, c);
+}
+
+inline const char *find_text_break(const char *begin, const char *end)
+{
+    return scalar_find_text_break(begin, end);
+}
+
+inline const char *skip_digits(const char *begin, const char *end)
+{
+    return scalar_skip_digits(begin, end);
+}
+
+#endif
+
+} // namespace detail
+} // namespace xlnt
@@ -0,0 +1,1167 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <xlnt/utils/exceptions.hpp>
+#include <detail/serialization/scan_kernels.hpp>
+#include <detail/serialization/sheet_data_scanner.hpp>
+
+namespace {
+
+using xlnt::detail::parsed_cell;
+using xlnt::detail::sheet_data_batch;
+using xlnt::detail::sheet_data_window;
+using xlnt::detail::string_slice;
+
+// how much of the sheetData body is read at a time
+const std::size_t chunk_size = 64 * 1024;
+
+// thrown when the input ends before the current row does, in which case the
+// row is read again from the start once more input is available
+struct incomplete_input
+{
+};
+
+struct malformed_input
+{
+    const char *what;
+};
+
+bool is_space(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+template <std::size_t N>
+bool equals(const string_slice &slice, const char (&literal)[N])
+{
+    return slice.size == N - 1 && std::memcmp(slice.data, literal, N - 1) == 0;
+}
+
+bool is_true(const string_slice &value)
+{
+    return equals(value, "1") || equals(value, "true");
+}
+
+template <typename T>
+T parse_unsigned(const string_slice &value)
+{
+    const auto digits_end = xlnt::detail::skip_digits(value.data, value.data + value.size);
+    auto result = T(0);
+
+    for (auto digit = value.data; digit != digits_end; ++digit)
+    {
+        result = static_cast<T>(result * 10 + static_cast<T>(*digit - '0'));
+    }
+
+    return result;
+}
+
+// only the letters of a cell reference matter since the row comes from <row>
+xlnt::column_t::index_t parse_column(const string_slice &reference)
+{
+    auto column = xlnt::column_t::index_t(0);
+
+    for (std::size_t i = 0; i < reference.size && reference.data[i] >= 'A' && reference.data[i] <= 'Z'; ++i)
+    {
+        column = column * 26 + static_cast<xlnt::column_t::index_t>(reference.data[i] - 'A' + 1);
+    }
+
+    return column;
+}
+
+xlnt::cell_type type_from_string(const string_slice &value)
+{
+    if (equals(value, "s"))
+    {
+        return xlnt::cell_type::shared_string;
+    }
+    else if (equals(value, "n"))
+    {
+        return xlnt::cell_type::number;
+    }
+    else if (equals(value, "b"))
+    {
+        return xlnt::cell_type::boolean;
+    }
+    else if (equals(value, "e"))
+    {
+        return xlnt::cell_type::error;
+    }
+    else if (equals(value, "inlineStr"))
+    {
+        return xlnt::cell_type::inline_string;
+    }
+    else if (equals(value, "str"))
+    {
+        return xlnt::cell_type::formula_string;
+    }
+    return xlnt::cell_type::shared_string;
+}
+
+void append_utf8(std::uint32_t code_point, std::string &out)
+{
+    if (code_point < 0x80)
+    {
+        out.push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x110000)
+    {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else
+    {
+        throw malformed_input{"invalid character reference"};
+    }
+}
+
+// appends text to out, normalising line ends and, outside of CDATA sections,
+// replacing references as an XML parser would
+void unescape(const char *data, std::size_t size, bool cdata, std::string &out)
+{
+    const auto end = data + size;
+
+    while (data != end)
+    {
+        if (*data == '\r')
+        {
+            out.push_back('\n');
+            data += data + 1 != end && data[1] == '\n' ? 2 : 1;
+        }
+        else if (*data == '&' && !cdata)
+        {
+            const auto semicolon = std::find(data, end, ';');
+
+            if (semicolon == end)
+            {
+                throw malformed_input{"unterminated reference"};
+            }
+
+            const auto name = string_slice{data + 1, static_cast<std::size_t>(semicolon - data - 1)};
+
+            if (equals(name, "lt"))
+            {
+                out.push_back('<');
+            }
+            else if (equals(name, "gt"))
+            {
+                out.push_back('>');
+            }
+            else if (equals(name, "amp"))
+            {
+                out.push_back('&');
+            }
+            else if (equals(name, "quot"))
+            {
+                out.push_back('"');
+            }
+            else if (equals(name, "apos"))
+            {
+                out.push_back('\'');
+            }
+            else if (name.size > 1 && name.data[0] == '#')
+            {
+                const auto hex = name.data[1] == 'x';
+                auto code_point = std::uint32_t(0);
+
+                for (auto digit = name.data + (hex ? 2 : 1); digit != semicolon; ++digit)
+                {
+                    auto value = std::uint32_t(0);
+
+                    if (*digit >= '0' && *digit <= '9')
+                    {
+                        value = static_cast<std::uint32_t>(*digit - '0');
+                    }
+                    else if (hex && *digit >= 'a' && *digit <= 'f')
+                    {
+                        value = static_cast<std::uint32_t>(*digit - 'a' + 10);
+                    }
+                    else if (hex && *digit >= 'A' && *digit <= 'F')
+                    {
+                        value = static_cast<std::uint32_t>(*digit - 'A' + 10);
+                    }
+                    else
+                    {
+                        throw malformed_input{"invalid character reference"};
+                    }
+
+                    code_point = code_point * (hex ? 16 : 10) + value;
+
+                    if (code_point >= 0x110000)
+                    {
+                        throw malformed_input{"invalid character reference"};
+                    }
+                }
+
+                append_utf8(code_point, out);
+            }
+            else
+            {
+                throw malformed_input{"undefined entity"};
+            }
+
+            data = semicolon + 1;
+        }
+        else
+        {
+            const auto next = std::find_if(data, end, [cdata](char c) { return c == '\r' || (c == '&' && !cdata); });
+            out.append(data, next);
+            data = next;
+        }
+    }
+}
+
+/// <summary>
+/// A position in the input of a batch. Reading past the end throws
+/// incomplete_input.
+/// </summary>
+class cursor
+{
+public:
+    cursor(const char *begin, const char *end)
+        : position(begin), end(end)
+    {
+    }
+
+    char peek() const
+    {
+        if (position == end)
+        {
+            throw incomplete_input();
+        }
+
+        return *position;
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c)
+        {
+            throw malformed_input{"unexpected character"};
+        }
+
+        ++position;
+    }
+
+    void skip_whitespace()
+    {
+        while (is_space(peek()))
+        {
+            ++position;
+        }
+    }
+
+    // true if the input at the cursor starts with literal
+    template <std::size_t N>
+    bool at(const char (&literal)[N]) const
+    {
+        const auto available = static_cast<std::size_t>(end - position);
+
+        // most calls are answered by the first character
+        if (available == 0 || *position != literal[0])
+        {
+            return false;
+        }
+
+        if (std::memcmp(position, literal, std::min(available, N - 1)) != 0)
+        {
+            return false;
+        }
+
+        if (available < N - 1)
+        {
+            throw incomplete_input();
+        }
+
+        return true;
+    }
+
+    const char *find(char c) const
+    {
+        auto match = xlnt::detail::find_byte(position, end, c);
+
+        if (match == end)
+        {
+            throw incomplete_input();
+        }
+
+        return match;
+    }
+
+    // returns the position just past the next occurrence of literal
+    template <std::size_t N>
+    const char *find_after(const char (&literal)[N]) const
+    {
+        auto match = std::search(position, end, literal, literal + N - 1);
+
+        if (match == end)
+        {
+            throw incomplete_input();
+        }
+
+        return match + N - 1;
+    }
+
+    const char *position;
+    const char *end;
+};
+
+// reads the name at the cursor and returns it without its namespace prefix
+string_slice read_name(cursor &c)
+{
+    auto start = c.position;
+
+    for (auto ch = c.peek(); !is_space(ch) && ch != '/' && ch != '>' && ch != '='; ch = c.peek())
+    {
+        if (ch == ':')
+        {
+            start = c.position + 1;
+        }
+
+        ++c.position;
+    }
+
+    if (c.position == start)
+    {
+        throw malformed_input{"missing name"};
+    }
+
+    return string_slice{start, static_cast<std::size_t>(c.position - start)};
+}
+
+// reads the attributes of the start tag at the cursor, passing each to handler,
+// and returns true if the element is empty, i.e. the tag ends with />
+template <typename Handler>
+bool read_attributes(cursor &c, Handler handler)
+{
+    while (true)
+    {
+        c.skip_whitespace();
+
+        const auto ch = c.peek();
+
+        if (ch == '>')
+        {
+            ++c.position;
+            return false;
+        }
+        else if (ch == '/')
+        {
+            ++c.position;
+            c.expect('>');
+            return true;
+        }
+
+        const auto name = read_name(c);
+        c.skip_whitespace();
+        c.expect('=');
+        c.skip_whitespace();
+
+        const auto quote = c.peek();
+
+        if (quote != '"' && quote != '\'')
+        {
+            throw malformed_input{"unquoted attribute value"};
+        }
+
+        ++c.position;
+        const auto close = c.find(quote);
+        handler(name, string_slice{c.position, static_cast<std::size_t>(close - c.position)});
+        c.position = close + 1;
+    }
+}
+
+bool skip_attributes(cursor &c)
+{
+    return read_attributes(c, [](const string_slice &, const string_slice &) {});
+}
+
+// skips comments, processing instructions and CDATA sections, returning false
+// if the cursor isn't at one of those
+bool skip_markup(cursor &c)
+{
+    if (c.end - c.position > 1 && c.position[1] != '!' && c.position[1] != '?')
+    {
+        return false;
+    }
+
+    if (c.at("<!--"))
+    {
+        c.position = c.find_after("-->");
+    }
+    else if (c.at("<![CDATA["))
+    {
+        c.position = c.find_after("]]>");
+    }
+    else if (c.at("<?"))
+    {
+        c.position = c.find_after("?>");
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void skip_end_tag(cursor &c)
+{
+    c.position = c.find('>') + 1;
+}
+
+// skips the children and end tag of an element whose start tag has been read
+void skip_children(cursor &c)
+{
+    auto depth = std::size_t(1);
+
+    while (depth > 0)
+    {
+        c.position = c.find('<');
+
+        if (c.at("</"))
+        {
+            skip_end_tag(c);
+            --depth;
+        }
+        else if (!skip_markup(c))
+        {
+            ++c.position;
+            read_name(c);
+
+            if (!skip_attributes(c))
+            {
+                ++depth;
+            }
+        }
+    }
+}
+
+// skips the rest of an element whose name has just been read
+void skip_content(cursor &c)
+{
+    if (!skip_attributes(c))
+    {
+        skip_children(c);
+    }
+}
+
+// reads the character content of the current element up to its end tag,
+// appending it to target
+void read_text(cursor &c, sheet_data_batch &batch, string_slice &target)
+{
+    std::string *joined = nullptr;
+
+    // plain is true if data has nothing to unescape
+    auto append = [&](const char *data, std::size_t size, bool plain, bool cdata) {
+        if (size == 0)
+        {
+            return;
+        }
+
+        // the common case of a single run of text without references needs no copy
+        if (plain && joined == nullptr && target.empty())
+        {
+            target = string_slice{data, size};
+            return;
+        }
+
+        if (joined == nullptr)
+        {
+            batch.unescaped.emplace_back(target.data, target.size);
+            joined = &batch.unescaped.back();
+        }
+
+        if (plain)
+        {
+            joined->append(data, size);
+        }
+        else
+        {
+            unescape(data, size, cdata, *joined);
+        }
+    };
+
+    while (true)
+    {
+        const auto start = c.position;
+        c.position = xlnt::detail::find_text_break(c.position, c.end);
+        const auto plain = c.peek() == '<';
+
+        if (!plain)
+        {
+            c.position = c.find('<');
+        }
+
+        append(start, static_cast<std::size_t>(c.position - start), plain, false);
+
+        if (c.at("</"))
+        {
+            skip_end_tag(c);
+            break;
+        }
+        else if (c.at("<![CDATA["))
+        {
+            const auto content = c.position + 9;
+            c.position = c.find_after("]]>");
+            const auto content_end = c.position - 3;
+            const auto plain = xlnt::detail::find_byte(content, content_end, '\r') == content_end;
+            append(content, static_cast<std::size_t>(content_end - content), plain, true);
+        }
+        else if (!skip_markup(c))
+        {
+            // none of the elements read as text should have children
+            ++c.position;
+            read_name(c);
+            skip_content(c);
+        }
+    }
+
+    if (joined != nullptr)
+    {
+        target = string_slice{joined->data(), joined->size()};
+    }
+}
+
+// <is> inside <c>, only plain <t> children are read
+void read_inline_string(cursor &c, sheet_data_batch &batch, string_slice &target)
+{
+    while (true)
+    {
+        c.position = c.find('<');
+
+        if (c.at("</"))
+        {
+            skip_end_tag(c);
+            break;
+        }
+        else if (skip_markup(c))
+        {
+            continue;
+        }
+
+        ++c.position;
+
+        if (equals(read_name(c), "t"))
+        {
+            if (!skip_attributes(c))
+            {
+                read_text(c, batch, target);
+            }
+        }
+        else
+        {
+            skip_content(c);
+        }
+    }
+}
+
+// <c> inside <row>, with the cursor after the element name
+void read_cell(cursor &c, sheet_data_batch &batch, const sheet_data_window &window,
+    xlnt::row_t row, xlnt::column_t::index_t &last_column)
+{
+    parsed_cell cell;
+    cell.row = row;
+
+    const auto empty = read_attributes(c, [&cell](const string_slice &name, const string_slice &value) {
+        if (equals(name, "r"))
+        {
+            cell.column = parse_column(value);
+        }
+        else if (equals(name, "t"))
+        {
+            cell.type = type_from_string(value);
+        }
+        else if (equals(name, "s"))
+        {
+            cell.style_index = parse_unsigned<int>(value);
+        }
+        else if (equals(name, "ph"))
+        {
+            cell.is_phonetic = is_true(value);
+        }
+        else if (equals(name, "cm"))
+        {
+            cell.cell_metadata_idx = parse_unsigned<int>(value);
+        }
+    });
+
+    // r is optional, in which case the cell follows the previous one
+    if (cell.column == 0)
+    {
+        cell.column = last_column + 1;
+    }
+
+    last_column = cell.column;
+
+    // cells outside of the window are only read for shared formula text,
+    // which the rest of its group may need
+    const auto inside = window.contains(cell.column, row);
+
+    if (!inside && empty)
+    {
+        return;
+    }
+
+    while (!empty)
+    {
+        c.position = c.find('<');
+
+        if (c.at("</"))
+        {
+            skip_end_tag(c);
+            break;
+        }
+        else if (skip_markup(c))
+        {
+            continue;
+        }
+
+        ++c.position;
+        const auto name = read_name(c);
+
+        if (equals(name, "v") && inside)
+        {
+            if (!skip_attributes(c))
+            {
+                read_text(c, batch, cell.value);
+            }
+        }
+        else if (equals(name, "f"))
+        {
+            const auto empty_formula = read_attributes(c, [&cell](const string_slice &name, const string_slice &value) {
+                if (equals(name, "t"))
+                {
+                    cell.shared_formula = equals(value, "shared");
+                }
+                else if (equals(name, "si"))
+                {
+                    cell.shared_formula_index = parse_unsigned<int>(value);
+                }
+                else if (equals(name, "ref"))
+                {
+                    cell.shared_formula_ref = value;
+                }
+            });
+
+            if (!empty_formula)
+            {
+                read_text(c, batch, cell.formula_string);
+            }
+        }
+        else if (equals(name, "is") && inside)
+        {
+            if (!skip_attributes(c))
+            {
+                read_inline_string(c, batch, cell.value);
+            }
+        }
+        else
+        {
+            skip_content(c);
+        }
+    }
+
+    if (inside)
+    {
+        batch.parsed_cells.push_back(cell);
+    }
+    else if (cell.shared_formula && !cell.formula_string.empty())
+    {
+        batch.outside_shared_formulas.push_back(cell);
+    }
+}
+
+// <row> inside <sheetData>, with the cursor after the element name, returning
+// false without reading the row if it comes after the window
+bool read_row(cursor &c, sheet_data_batch &batch, const sheet_data_window &window,
+    const xlnt::detail::number_serialiser &converter, xlnt::row_t &last_row)
+{
+    std::pair<xlnt::row_properties, xlnt::row_t> props;
+    props.second = 0;
+
+    const auto empty = read_attributes(c, [&props, &converter](const string_slice &name, const string_slice &value) {
+        if (equals(name, "r"))
+        {
+            props.second = parse_unsigned<xlnt::row_t>(value);
+        }
+        else if (equals(name, "dyDescent") && !value.empty())
+        {
+            props.first.dy_descent = converter.deserialise(value.data, value.size);
+        }
+        else if (equals(name, "spans"))
+        {
+            props.first.spans = value.to_string();
+        }
+        else if (equals(name, "ht") && !value.empty())
+        {
+            props.first.height = converter.deserialise(value.data, value.size);
+        }
+        else if (equals(name, "s"))
+        {
+            props.first.style = parse_unsigned<std::size_t>(value);
+        }
+        else if (equals(name, "hidden"))
+        {
+            props.first.hidden = is_true(value);
+        }
+        else if (equals(name, "customFormat"))
+        {
+            props.first.custom_format = is_true(value);
+        }
+        else if (equals(name, "customHeight"))
+        {
+            props.first.custom_height = is_true(value);
+        }
+    });
+
+    // r is optional, in which case the row follows the previous one
+    if (props.second == 0)
+    {
+        props.second = last_row + 1;
+    }
+
+    last_row = props.second;
+
+    if (props.second > window.last_row)
+    {
+        return false;
+    }
+
+    auto last_column = xlnt::column_t::index_t(0);
+
+    while (!empty)
+    {
+        c.position = c.find('<');
+
+        if (c.at("</"))
+        {
+            skip_end_tag(c);
+            break;
+        }
+        else if (skip_markup(c))
+        {
+            continue;
+        }
+
+        ++c.position;
+
+        if (equals(read_name(c), "c"))
+        {
+            read_cell(c, batch, window, props.second, last_column);
+        }
+        else
+        {
+            skip_content(c);
+        }
+    }
+
+    if (window.contains_row(props.second))
+    {
+        batch.parsed_rows.push_back(std::move(props));
+    }
+
+    return true;
+}
+
+// returns the index just past the markup starting at text[start] or npos if
+// the markup doesn't end within text
+std::size_t markup_end(const std::string &text, std::size_t start)
+{
+    // long enough to tell the kinds of markup apart
+    if (text.size() - start < 9)
+    {
+        return std::string::npos;
+    }
+
+    auto find_after = [&text](const char *terminator, std::size_t from) {
+        const auto match = text.find(terminator, from);
+        return match == std::string::npos ? match : match + std::strlen(terminator);
+    };
+
+    if (text.compare(start, 4, "<!--") == 0)
+    {
+        return find_after("-->", start + 4);
+    }
+    else if (text.compare(start, 9, "<![CDATA[") == 0)
+    {
+        return find_after("]]>", start + 9);
+    }
+    else if (text.compare(start, 2, "<?") == 0)
+    {
+        return find_after("?>", start + 2);
+    }
+
+    // tags end at the first > outside of an attribute value
+    auto quote = '\0';
+
+    for (auto i = start + 1; i < text.size(); ++i)
+    {
+        if (quote != '\0')
+        {
+            quote = text[i] == quote ? '\0' : quote;
+        }
+        else if (text[i] == '"' || text[i] == '\'')
+        {
+            quote = text[i];
+        }
+        else if (text[i] == '>')
+        {
+            return i + 1;
+        }
+    }
+
+    return std::string::npos;
+}
+
+} // namespace
+
+namespace xlnt {
+namespace detail {
+
+void sheet_data_batch::clear()
+{
+    input.clear();
+    parsed_rows.clear();
+    parsed_cells.clear();
+    outside_shared_formulas.clear();
+    unescaped.clear();
+    last = false;
+    truncated = false;
+    error = nullptr;
+}
+
+sheet_data_splitter::sheet_data_splitter(std::streambuf &source, const std::string &name)
+    : source_(source),
+      name_(name),
+      buffer_(4096)
+{
+}
+
+bool sheet_data_splitter::has_body() const
+{
+    return has_body_;
+}
+
+std::size_t sheet_data_splitter::read_body(char *destination, std::size_t count)
+{
+    auto copied = std::min(count, body_.size() - body_position_);
+    std::copy(body_.data() + body_position_, body_.data() + body_position_ + copied, destination);
+    body_position_ += copied;
+
+    while (copied < count)
+    {
+        const auto read = source_.sgetn(destination + copied, static_cast<std::streamsize>(count - copied));
+
+        if (read <= 0)
+        {
+            break;
+        }
+
+        copied += static_cast<std::size_t>(read);
+    }
+
+    return copied;
+}
+
+void sheet_data_splitter::end_body(const char *rest, std::size_t count)
+{
+    pending_ = root_tag_;
+    pending_.append(rest, count);
+    pending_served_ = false;
+    passthrough_ = true;
+    setg(nullptr, nullptr, nullptr);
+}
+
+xml::parser &sheet_data_splitter::tail()
+{
+    if (tail_parser_ == nullptr)
+    {
+        tail_stream_.reset(new std::istream(this));
+        tail_parser_.reset(new xml::parser(*tail_stream_, name_));
+    }
+
+    return *tail_parser_;
+}
+
+const std::string &sheet_data_splitter::name() const
+{
+    return name_;
+}
+
+sheet_data_splitter::int_type sheet_data_splitter::underflow()
+{
+    if (!head_read_)
+    {
+        read_head();
+    }
+
+    if (!pending_served_)
+    {
+        pending_served_ = true;
+
+        if (!pending_.empty())
+        {
+            setg(&pending_[0], &pending_[0], &pending_[0] + pending_.size());
+            return traits_type::to_int_type(pending_[0]);
+        }
+    }
+
+    if (!passthrough_)
+    {
+        return traits_type::eof();
+    }
+
+    const auto count = source_.sgetn(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+
+    if (count <= 0)
+    {
+        return traits_type::eof();
+    }
+
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + count);
+
+    return traits_type::to_int_type(buffer_[0]);
+}
+
+void sheet_data_splitter::read_head()
+{
+    head_read_ = true;
+
+    std::string head;
+    std::size_t scanned = 0;
+
+    while (true)
+    {
+        auto start = head.find('<', scanned);
+
+        for (; start != std::string::npos; start = head.find('<', scanned))
+        {
+            const auto end = markup_end(head, start);
+
+            if (end == std::string::npos)
+            {
+                break;
+            }
+
+            scanned = end;
+
+            if (head[start + 1] == '/' || head[start + 1] == '!' || head[start + 1] == '?')
+            {
+                continue;
+            }
+
+            const auto name_end = head.find_first_of(" \t\r\n/>", start + 1);
+            const auto name = head.substr(start + 1, name_end - start - 1);
+
+            if (root_tag_.empty())
+            {
+                root_tag_ = head.substr(start, end - start);
+                root_name_ = name;
+
+                continue;
+            }
+
+            const auto colon = name.find(':');
+
+            if (name.compare(colon == std::string::npos ? 0 : colon + 1, std::string::npos, "sheetData") != 0)
+            {
+                continue;
+            }
+
+            // an empty <sheetData/> is left to the parser along with everything else
+            has_body_ = head[end - 2] != '/';
+            passthrough_ = !has_body_;
+
+            if (has_body_)
+            {
+                body_ = head.substr(end);
+                head.resize(end);
+                head.append("</" + name + "></" + root_name_ + ">");
+            }
+
+            pending_ = std::move(head);
+
+            return;
+        }
+
+        if (start != std::string::npos)
+        {
+            scanned = start;
+        }
+        else
+        {
+            scanned = head.size();
+        }
+
+        const auto count = source_.sgetn(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+
+        if (count <= 0)
+        {
+            // no sheetData at all
+            pending_ = std::move(head);
+            passthrough_ = true;
+
+            return;
+        }
+
+        head.append(buffer_.data(), static_cast<std::size_t>(count));
+    }
+}
+
+sheet_data_scanner::sheet_data_scanner(sheet_data_splitter &source, const sheet_data_window &window)
+    : source_(source),
+      window_(window)
+{
+}
+
+bool sheet_data_scanner::fill(sheet_data_batch &batch)
+{
+    batch.clear();
+    batch.input.swap(carry_);
+
+    // the start of the first row that hasn't been read yet
+    auto position = std::size_t(0);
+    // whether a whole row has been read, or skipped, from this batch's input
+    auto row_read = false;
+    // how much more input to read before scanning again
+    auto read_size = chunk_size;
+
+    try
+    {
+        while (true)
+        {
+            // nothing has been sliced from the input at this point, so it may move
+            const auto size = batch.input.size();
+            batch.input.resize(size + read_size);
+            const auto count = source_.read_body(batch.input.data() + size, read_size);
+            batch.input.resize(size + count);
+
+            if (count == 0)
+            {
+                throw xlnt::exception(source_.name() + ": unexpected end of sheetData");
+            }
+
+            cursor c(batch.input.data() + position, batch.input.data() + batch.input.size());
+
+            while (true)
+            {
+                const auto row_start = c.position;
+                const auto rows = batch.parsed_rows.size();
+                const auto cells = batch.parsed_cells.size();
+                const auto outside_shared_formulas = batch.outside_shared_formulas.size();
+                const auto unescaped = batch.unescaped.size();
+                const auto last_row = last_row_;
+
+                try
+                {
+                    c.position = c.find('<');
+
+                    if (c.at("</"))
+                    {
+                        skip_end_tag(c);
+                        source_.end_body(c.position, static_cast<std::size_t>(c.end - c.position));
+                        batch.last = true;
+
+                        return true;
+                    }
+                    else if (skip_markup(c))
+                    {
+                        continue;
+                    }
+
+                    ++c.position;
+
+                    if (equals(read_name(c), "row"))
+                    {
+                        if (!read_row(c, batch, window_, converter_, last_row_))
+                        {
+                            // the rest of the part is never inflated
+                            batch.last = true;
+                            batch.truncated = true;
+
+                            return true;
+                        }
+
+                        row_read = true;
+                    }
+                    else
+                    {
+                        skip_content(c);
+                    }
+                }
+                catch (incomplete_input &)
+                {
+                    batch.parsed_rows.resize(rows);
+                    batch.parsed_cells.resize(cells);
+                    batch.outside_shared_formulas.resize(outside_shared_formulas);
+                    batch.unescaped.resize(unescaped);
+                    last_row_ = last_row;
+
+                    const auto offset = static_cast<std::size_t>(row_start - batch.input.data());
+
+                    if (row_read)
+                    {
+                        // leave the incomplete row for the next batch
+                        carry_.assign(row_start, c.end);
+                        batch.input.resize(offset);
+
+                        return false;
+                    }
+
+                    // not even one row fits, so keep reading into this batch,
+                    // at least doubling what has been read of the row so that
+                    // a huge row is rescanned only a logarithmic number of times
+                    position = offset;
+                    read_size = std::max(chunk_size, batch.input.size() - position);
+                    break;
+                }
+            }
+        }
+    }
+    catch (malformed_input &e)
+    {
+        throw xlnt::exception(source_.name() + ": " + e.what + " in sheetData");
+    }
+}
+
+} // namespace detail
+} // namespace xlnt
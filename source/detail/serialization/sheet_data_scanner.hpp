@@ -0,0 +1,269 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <xlnt/cell/cell_type.hpp>
+#include <xlnt/cell/index_types.hpp>
+#include <xlnt/utils/numeric.hpp>
+#include <xlnt/utils/optional.hpp>
+#include <xlnt/worksheet/row_properties.hpp>
+#include <detail/external/include_libstudxml.hpp>
+
+namespace xlnt {
+namespace detail {
+
+/// <summary>
+/// Characters read by sheet_data_scanner. These point into the input of the
+/// batch they belong to or, if they had to be unescaped or joined, into the
+/// batch's own storage. Either way they live as long as the batch's contents.
+/// </summary>
+struct string_slice
+{
+    const char *data = nullptr;
+    std::size_t size = 0;
+
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    std::string to_string() const
+    {
+        return std::string(data, size);
+    }
+};
+
+/// <summary>
+/// The rows and columns of sheetData that sheet_data_scanner keeps. Rows are
+/// written in ascending order, so nothing after the first row past last_row
+/// needs to be read.
+/// </summary>
+struct sheet_data_window
+{
+    row_t first_row = 1;
+    row_t last_row = std::numeric_limits<row_t>::max();
+    column_t::index_t first_column = 1;
+    column_t::index_t last_column = std::numeric_limits<column_t::index_t>::max();
+
+    bool contains_row(row_t row) const
+    {
+        return row >= first_row && row <= last_row;
+    }
+
+    bool contains_column(column_t::index_t column) const
+    {
+        return column >= first_column && column <= last_column;
+    }
+
+    bool contains(column_t::index_t column, row_t row) const
+    {
+        return contains_column(column) && contains_row(row);
+    }
+};
+
+/// <summary>
+/// A <c> element inside a <row>.
+/// </summary>
+struct parsed_cell
+{
+    bool is_phonetic = false; // 'ph'
+    cell_type type = cell_type::number; // 't'
+    int cell_metadata_idx = -1; // 'cm'
+    int style_index = -1; // 's'
+    column_t::index_t column = 0; // 'r'
+    row_t row = 0; // from the parent <row>
+    string_slice value; // <v> OR <is>
+    string_slice formula_string; // <f>
+    bool shared_formula = false; // <f t="shared">
+    int shared_formula_index = -1; // <f si>
+    string_slice shared_formula_ref; // <f ref>, only on the cell holding the formula text
+};
+
+/// <summary>
+/// A run of whole <row> elements from <sheetData> along with the input
+/// they were read from.
+/// </summary>
+struct sheet_data_batch
+{
+    /// <summary>
+    /// Removes the rows and cells but keeps the allocated storage for reuse.
+    /// </summary>
+    void clear();
+
+    std::vector<char> input;
+    std::vector<std::pair<row_properties, row_t>> parsed_rows;
+    std::vector<parsed_cell> parsed_cells;
+
+    /// <summary>
+    /// Cells outside of the window that hold the text of a shared formula, so
+    /// that the cells of its group inside the window can still be given theirs.
+    /// Only their position and formula are read.
+    /// </summary>
+    std::vector<parsed_cell> outside_shared_formulas;
+
+    /// <summary>
+    /// Text that couldn't be sliced straight from input. A deque so that
+    /// adding a string doesn't move the ones already referred to.
+    /// </summary>
+    std::deque<std::string> unescaped;
+
+    bool last = false; // </sheetData> or the end of the window was reached
+    bool truncated = false; // rows past the window were left unread, along with the rest of the part
+    std::exception_ptr error; // set instead of throwing when read on another thread
+};
+
+/// <summary>
+/// Splits a worksheet part so that <sheetData>, which is nearly all of a
+/// typical part, can be read by sheet_data_scanner instead of the generic
+/// XML parser. As a streambuf it first yields everything up to the end of the
+/// <sheetData> start tag followed by the end tags that close the document.
+/// The body of sheetData is then read with read_body() until end_body() hands
+/// back whatever followed </sheetData>. After that tail() is a parser for the
+/// rest of the part, starting with a copy of the root start tag.
+/// If sheetData is missing or empty the part is passed through unchanged.
+/// </summary>
+class sheet_data_splitter : public std::streambuf
+{
+    using int_type = std::streambuf::int_type;
+
+public:
+    sheet_data_splitter(std::streambuf &source, const std::string &name);
+
+    sheet_data_splitter(const sheet_data_splitter &) = delete;
+    sheet_data_splitter &operator=(const sheet_data_splitter &) = delete;
+
+    /// <summary>
+    /// Returns true if the part has a sheetData body to be scanned. Only
+    /// meaningful once the sheetData start tag has been parsed.
+    /// </summary>
+    bool has_body() const;
+
+    /// <summary>
+    /// Copies up to count characters of the sheetData body into destination
+    /// and returns the number copied, which is zero at the end of the part.
+    /// </summary>
+    std::size_t read_body(char *destination, std::size_t count);
+
+    /// <summary>
+    /// Ends the body. The given characters, which were read by read_body()
+    /// but follow </sheetData>, start the rest of the part.
+    /// </summary>
+    void end_body(const char *rest, std::size_t count);
+
+    /// <summary>
+    /// Returns a parser for the part after </sheetData>.
+    /// </summary>
+    xml::parser &tail();
+
+    /// <summary>
+    /// The name of the part, for error messages.
+    /// </summary>
+    const std::string &name() const;
+
+private:
+    int_type underflow();
+
+    void read_head();
+
+    std::streambuf &source_;
+    std::string name_;
+
+    bool head_read_ = false;
+    bool has_body_ = false;
+
+    /// <summary>
+    /// Characters to be returned by underflow before any more are taken
+    /// from source_, if passthrough_ is set.
+    /// </summary>
+    std::string pending_;
+    bool pending_served_ = false;
+    bool passthrough_ = false;
+    std::vector<char> buffer_;
+
+    /// <summary>
+    /// The start tag of the document element and its name as written, prefix included.
+    /// </summary>
+    std::string root_tag_;
+    std::string root_name_;
+
+    /// <summary>
+    /// The start of the body, read from source_ along with the head.
+    /// </summary>
+    std::string body_;
+    std::size_t body_position_ = 0;
+
+    std::unique_ptr<std::istream> tail_stream_;
+    std::unique_ptr<xml::parser> tail_parser_;
+};
+
+/// <summary>
+/// Reads the body of <sheetData> into batches of rows and cells without
+/// building a DOM or an attribute map. Attribute values and text are sliced
+/// straight from the batch's input, which is filled a chunk at a time so that
+/// memory use doesn't depend on the size of the sheet. Only the elements and
+/// attributes that xlsx_consumer uses are read, everything else is skipped.
+/// Rows and cells outside of the window are skipped too, apart from the text
+/// of any shared formula they hold, and the first row past its end stops the
+/// scan without reading the rest of the part.
+/// </summary>
+class sheet_data_scanner
+{
+public:
+    explicit sheet_data_scanner(sheet_data_splitter &source,
+        const sheet_data_window &window = sheet_data_window());
+
+    /// <summary>
+    /// Replaces the contents of batch with the next run of whole rows and
+    /// returns true once </sheetData> or the end of the window has been
+    /// reached, in which case batch.last is also set. In the latter case
+    /// batch.truncated is set as well and the splitter has no tail.
+    /// </summary>
+    bool fill(sheet_data_batch &batch);
+
+private:
+    sheet_data_splitter &source_;
+    sheet_data_window window_;
+
+    /// <summary>
+    /// The incomplete row at the end of the previous batch's input.
+    /// </summary>
+    std::vector<char> carry_;
+
+    row_t last_row_ = 0;
+    number_serialiser converter_;
+};
+
+} // namespace detail
+} // namespace xlnt
@@ -21,9 +21,17 @@
 // @license: http://www.opensource.org/licenses/mit-license.php
 // @author: see AUTHORS file
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
 #include <numeric> // for std::accumulate
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 
 #include <xlnt/cell/cell.hpp>
@@ -33,6 +41,7 @@
 #include <xlnt/packaging/manifest.hpp>
 #include <xlnt/utils/optional.hpp>
 #include <xlnt/utils/path.hpp>
+#include <xlnt/workbook/row_buffer.hpp>
 #include <xlnt/workbook/workbook.hpp>
 #include <xlnt/worksheet/selection.hpp>
 #include <xlnt/worksheet/worksheet.hpp>
@@ -40,6 +49,7 @@
 #include <detail/header_footer/header_footer_code.hpp>
 #include <detail/implementations/workbook_impl.hpp>
 #include <detail/serialization/custom_value_traits.hpp>
+#include <detail/serialization/sheet_data_scanner.hpp>
 #include <detail/serialization/vector_streambuf.hpp>
 #include <detail/serialization/xlsx_consumer.hpp>
 #include <detail/serialization/zstream.hpp>
@@ -75,7 +85,8 @@ inline bool string_equal(const std::string &lhs, const char (&rhs)[N])
 xml::qname &qn(const std::string &namespace_, const std::string &name)
 {
     using qname_map = std::unordered_map<std::string, xml::qname>;
-    static auto &memo = *new std::unordered_map<std::string, qname_map>();
+    // per thread since worksheets may be read concurrently
+    static thread_local std::unordered_map<std::string, qname_map> memo;
 
     auto &ns_memo = memo[namespace_];
 
@@ -110,314 +121,143 @@ bool is_true(const std::string &bool_string)
 #endif
 }
 
-using style_id_pair = std::pair<xlnt::detail::style_impl, std::size_t>;
-
 /// <summary>
-/// Try to find given xfid value in the styles vector and, if succeeded, set's the optional style.
+/// Returns the shared string index held by the value of a cell.
 /// </summary>
-void set_style_by_xfid(const std::vector<style_id_pair> &styles,
-    std::size_t xfid, xlnt::optional<std::string> &style)
+double parse_index(const xlnt::detail::string_slice &value)
 {
-    for (auto &item : styles)
-    {
-        if (item.second == xfid)
-        {
-            style = item.first.name;
-        }
-    }
-}
-
-/// parsing assumptions used by the following functions
-/// - on entry, the start element for the element has been consumed by parser->next
-/// - on exit, the closing element has been consumed by parser->next
-/// using these assumptions, the following functions DO NOT use parser->peek (SLOW!!!)
-/// probable further gains from not building an attribute map and using the attribute events instead as the impl just iterates the map
+    auto index = std::size_t(0);
 
-/// 'r' == cell reference e.g. 'A1'
-/// https://docs.microsoft.com/en-us/openspecs/office_standards/ms-oe376/db11a912-b1cb-4dff-b46d-9bedfd10cef0
-///
-/// a lightweight version of xlnt::cell_reference with no extre functionality (absolute/relative, ...)
-/// many thousands are created during parsing, so even minor overhead is noticable
-struct Cell_Reference
-{
-    // not commonly used, added as the obvious ctor
-    explicit Cell_Reference(xlnt::row_t row_arg, xlnt::column_t::index_t column_arg) noexcept
-        : row(row_arg), column(column_arg)
-    {
-    }
-    // the common case. row # is already known during parsing (from parent <row> element)
-    // just need to evaluate the column
-    explicit Cell_Reference(xlnt::row_t row_arg, const std::string &reference) noexcept
-        : row(row_arg)
+    for (std::size_t i = 0; i < value.size && value.data[i] >= '0' && value.data[i] <= '9'; ++i)
     {
-        // only three characters allowed for the column
-        // assumption:
-        // - regex pattern match: [A-Z]{1,3}\d{1,7}
-        const char *iter = reference.c_str();
-        int temp = *iter - 'A' + 1; // 'A' == 1
-        ++iter;
-        if (*iter >= 'A') // second char
-        {
-            temp *= 26; // LHS values are more significant
-            temp += *iter - 'A' + 1; // 'A' == 1
-            ++iter;
-            if (*iter >= 'A') // third char
-            {
-                temp *= 26; // LHS values are more significant
-                temp += *iter - 'A' + 1; // 'A' == 1
-            }
-        }
-        column = static_cast<xlnt::column_t::index_t>(temp);
+        index = index * 10 + static_cast<std::size_t>(value.data[i] - '0');
     }
 
-    xlnt::row_t row; // range:[1, 1048576]
-    xlnt::column_t::index_t column; // range:["A", "ZZZ"] -> [1, 26^3] -> [1, 17576]
-};
-
-// <c> inside <row> element
-// https://docs.microsoft.com/en-us/dotnet/api/documentformat.openxml.spreadsheet.cell?view=openxml-2.8.1
-struct Cell
-{
-    bool is_phonetic = false; // 'ph'
-    xlnt::cell::type type = xlnt::cell::type::number; // 't'
-    int cell_metatdata_idx = -1; // 'cm'
-    int style_index = -1; // 's'
-    Cell_Reference ref{0, 0}; // 'r'
-    std::string value; // <v> OR <is>
-    std::string formula_string; // <f>
-};
+    return static_cast<double>(index);
+}
 
-// <sheetData> element
-struct Sheet_Data
+/// <summary>
+/// Returns the window of cells that options asks to be read from each worksheet.
+/// </summary>
+xlnt::detail::sheet_data_window sheet_window(const xlnt::load_options &options)
 {
-    std::vector<std::pair<xlnt::row_properties, xlnt::row_t>> parsed_rows;
-    std::vector<Cell> parsed_cells;
-};
+    xlnt::detail::sheet_data_window window;
 
-xlnt::cell::type type_from_string(const std::string &str)
-{
-    if (string_equal(str, "s"))
-    {
-        return xlnt::cell::type::shared_string;
-    }
-    else if (string_equal(str, "n"))
+    if (options.first_row.is_set())
     {
-        return xlnt::cell::type::number;
+        window.first_row = options.first_row.get();
     }
-    else if (string_equal(str, "b"))
-    {
-        return xlnt::cell::type::boolean;
-    }
-    else if (string_equal(str, "e"))
+
+    if (options.last_row.is_set())
     {
-        return xlnt::cell::type::error;
+        window.last_row = options.last_row.get();
     }
-    else if (string_equal(str, "inlineStr"))
+
+    if (options.first_column.is_set())
     {
-        return xlnt::cell::type::inline_string;
+        window.first_column = options.first_column.get().index;
     }
-    else if (string_equal(str, "str"))
+
+    if (options.last_column.is_set())
     {
-        return xlnt::cell::type::formula_string;
+        window.last_column = options.last_column.get().index;
     }
-    return xlnt::cell::type::shared_string;
+
+    return window;
 }
 
-Cell parse_cell(xlnt::row_t row_arg, xml::parser *parser)
+using style_id_pair = std::pair<xlnt::detail::style_impl, std::size_t>;
+
+/// <summary>
+/// Try to find given xfid value in the styles vector and, if succeeded, set's the optional style.
+/// </summary>
+void set_style_by_xfid(const std::vector<style_id_pair> &styles,
+    std::size_t xfid, xlnt::optional<std::string> &style)
 {
-    Cell c;
-    for (auto &attr : parser->attribute_map())
-    {
-        if (string_equal(attr.first.name(), "r"))
-        {
-            c.ref = Cell_Reference(row_arg, attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "t"))
-        {
-            c.type = type_from_string(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "s"))
-        {
-            c.style_index = static_cast<int>(strtol(attr.second.value.c_str(), nullptr, 10));
-        }
-        else if (string_equal(attr.first.name(), "ph"))
-        {
-            c.is_phonetic = is_true(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "cm"))
-        {
-            c.cell_metatdata_idx = static_cast<int>(strtol(attr.second.value.c_str(), nullptr, 10));
-        }
-    }
-    int level = 1; // nesting level
-        // 1 == <c>
-        // 2 == <v>/<is>/<f>
-        // exit loop at </c>
-    while (level > 0)
+    for (auto &item : styles)
     {
-        xml::parser::event_type e = parser->next();
-        switch (e)
+        if (item.second == xfid)
         {
-        case xml::parser::start_element: {
-            ++level;
-            break;
-        }
-        case xml::parser::end_element: {
-            --level;
-            break;
-        }
-        case xml::parser::characters: {
-            // only want the characters inside one of the nested tags
-            // without this a lot of formatting whitespace can get added
-            if (level == 2)
-            {
-                // <v> -> numeric values
-                // <is><t> -> inline string
-                if (string_equal(parser->name(), "v"))
-                {
-                    c.value += std::move(parser->value());
-                }
-                // <f> formula
-                else if (string_equal(parser->name(), "f"))
-                {
-                    c.formula_string += std::move(parser->value());
-                }
-            }
-            else if (level == 3)
-            {
-                // <is><t> -> inline string
-                if (string_equal(parser->name(), "t"))
-                {
-                    c.value += std::move(parser->value());
-                }
-            }
-            break;
-        }
-        case xml::parser::start_namespace_decl:
-        case xml::parser::end_namespace_decl:
-        case xml::parser::start_attribute:
-        case xml::parser::end_attribute:
-        case xml::parser::eof:
-        default: {
-            throw xlnt::exception("unexcpected XML parsing event");
-        }
+            style = item.first.name;
         }
     }
-    return c;
 }
 
-// <row> inside <sheetData> element
-std::pair<xlnt::row_properties, int> parse_row(xml::parser *parser, xlnt::detail::number_serialiser &converter, std::vector<Cell> &parsed_cells)
+/// <summary>
+/// A bounded blocking queue for handing sheet data batches from the thread
+/// scanning <sheetData> to the thread building the cells. Closing the queue
+/// wakes up both sides and makes further pushes fail, which is how either
+/// side abandons the pipeline on an error.
+/// </summary>
+class batch_queue
 {
-    std::pair<xlnt::row_properties, int> props;
-    for (auto &attr : parser->attribute_map())
+public:
+    bool push(std::unique_ptr<xlnt::detail::sheet_data_batch> batch)
     {
-        if (string_equal(attr.first.name(), "dyDescent"))
-        {
-            props.first.dy_descent = converter.deserialise(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "spans"))
-        {
-            props.first.spans = attr.second.value;
-        }
-        else if (string_equal(attr.first.name(), "ht"))
-        {
-            props.first.height = converter.deserialise(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "s"))
-        {
-            props.first.style = strtoul(attr.second.value.c_str(), nullptr, 10);
-        }
-        else if (string_equal(attr.first.name(), "hidden"))
-        {
-            props.first.hidden = is_true(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "customFormat"))
-        {
-            props.first.custom_format = is_true(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "ph"))
-        {
-            is_true(attr.second.value);
-        }
-        else if (string_equal(attr.first.name(), "r"))
-        {
-            props.second = static_cast<int>(strtol(attr.second.value.c_str(), nullptr, 10));
-        }
-        else if (string_equal(attr.first.name(), "customHeight"))
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (closed_)
         {
-            props.first.custom_height = is_true(attr.second.value.c_str());
+            return false;
         }
+
+        batches_.push_back(std::move(batch));
+        ready_.notify_one();
+
+        return true;
     }
 
-    int level = 1;
-    while (level > 0)
+    std::unique_ptr<xlnt::detail::sheet_data_batch> pop()
     {
-        xml::parser::event_type e = parser->next();
-        switch (e)
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return closed_ || !batches_.empty(); });
+
+        if (batches_.empty())
         {
-        case xml::parser::start_element: {
-            parsed_cells.push_back(parse_cell(static_cast<xlnt::row_t>(props.second), parser));
-            break;
-        }
-        case xml::parser::end_element: {
-            --level;
-            break;
-        }
-        case xml::parser::characters: {
-            // ignore whitespace
-            break;
-        }
-        case xml::parser::start_namespace_decl:
-        case xml::parser::start_attribute:
-        case xml::parser::end_namespace_decl:
-        case xml::parser::end_attribute:
-        case xml::parser::eof:
-        default: {
-            throw xlnt::exception("unexcpected XML parsing event");
-        }
+            return nullptr;
         }
+
+        auto batch = std::move(batches_.front());
+        batches_.pop_front();
+
+        return batch;
     }
-    return props;
-}
 
-// <sheetData> inside <worksheet> element
-Sheet_Data parse_sheet_data(xml::parser *parser, xlnt::detail::number_serialiser &converter)
-{
-    Sheet_Data sheet_data;
-    int level = 1; // nesting level
-        // 1 == <sheetData>
-        // 2 == <row>
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        ready_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::unique_ptr<xlnt::detail::sheet_data_batch>> batches_;
+    bool closed_ = false;
+};
+
+// batches in flight between the two threads, including the one being built
+const std::size_t sheet_data_batch_count = 3;
 
-    while (level > 0)
+/// <summary>
+/// A package read into memory so that it outlives the stream it came from.
+/// </summary>
+struct retained_archive
+{
+    explicit retained_archive(std::istream &source)
+        : data((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>()),
+          buffer(data),
+          stream(&buffer),
+          archive(stream)
     {
-        xml::parser::event_type e = parser->next();
-        switch (e)
-        {
-        case xml::parser::start_element: {
-            sheet_data.parsed_rows.push_back(parse_row(parser, converter, sheet_data.parsed_cells));
-            break;
-        }
-        case xml::parser::end_element: {
-            --level;
-            break;
-        }
-        case xml::parser::characters: {
-            // ignore, whitespace formatting normally
-            break;
-        }
-        case xml::parser::start_namespace_decl:
-        case xml::parser::start_attribute:
-        case xml::parser::end_namespace_decl:
-        case xml::parser::end_attribute:
-        case xml::parser::eof:
-        default: {
-            throw xlnt::exception("unexcpected XML parsing event");
-        }
-        }
     }
-    return sheet_data;
-}
+
+    std::vector<std::uint8_t> data;
+    xlnt::detail::vector_istreambuf buffer;
+    std::istream stream;
+    xlnt::detail::izstream archive;
+};
 
 } // namespace
 
@@ -447,16 +287,70 @@ xlsx_consumer::xlsx_consumer(workbook &target)
 {
 }
 
+xlsx_consumer::xlsx_consumer(workbook &target, const load_options &options)
+    : target_(target),
+      parser_(nullptr),
+      options_(options)
+{
+}
+
 xlsx_consumer::~xlsx_consumer()
 {
 }
 
 void xlsx_consumer::read(std::istream &source)
 {
-    archive_.reset(new izstream(source));
+    if (options_.lazy_worksheets)
+    {
+        // worksheets are read after this returns, by which time source may be gone
+        auto retained = std::make_shared<retained_archive>(source);
+        archive_ = std::shared_ptr<izstream>(retained, &retained->archive);
+    }
+    else
+    {
+        archive_.reset(new izstream(source));
+    }
+
     populate_workbook(false);
 }
 
+void xlsx_consumer::read_deferred_worksheet(workbook &target, worksheet_impl &worksheet)
+{
+    auto &impl = *target.d_;
+
+    xlsx_consumer consumer(target, impl.deferred_options_);
+    consumer.archive_ = impl.deferred_archive_;
+    consumer.current_worksheet_ = &worksheet;
+    consumer.reading_deferred_ = true;
+
+    const auto workbook_rel = impl.manifest_.relationship(path("/"), relationship_type::office_document);
+    const auto worksheet_rel = impl.manifest_.relationship(workbook_rel.target().path(),
+        impl.sheet_title_rel_id_map_.at(worksheet.title_));
+
+    // the worksheet is still empty, so this copy is cheap and is what it's
+    // put back to if reading fails, to be tried again on the next access
+    const auto unread = worksheet;
+
+    // cleared while reading so that looking the worksheet up doesn't read it again
+    worksheet.deferred_ = false;
+
+    try
+    {
+        consumer.read_part({workbook_rel, worksheet_rel});
+    }
+    catch (...)
+    {
+        worksheet = unread;
+        throw;
+    }
+
+    if (std::none_of(impl.worksheets_.begin(), impl.worksheets_.end(),
+            [](const worksheet_impl &ws) { return ws.deferred_; }))
+    {
+        impl.deferred_archive_.reset();
+    }
+}
+
 void xlsx_consumer::open(std::istream &source)
 {
     archive_.reset(new izstream(source));
@@ -470,177 +364,127 @@ cell xlsx_consumer::read_cell()
         return cell(nullptr);
     }
 
-    auto ws = worksheet(current_worksheet_);
-
-    if (in_element(qn("spreadsheetml", "sheetData")))
-    {
-        expect_start_element(qn("spreadsheetml", "row"), xml::content::complex); // CT_Row
-        auto row_index = static_cast<row_t>(std::stoul(parser().attribute("r")));
-        auto &row_properties = ws.row_properties(row_index);
-
-        if (parser().attribute_present("ht"))
-        {
-            row_properties.height = converter_.deserialise(parser().attribute("ht"));
-        }
-
-        if (parser().attribute_present("customHeight"))
-        {
-            row_properties.custom_height = is_true(parser().attribute("customHeight"));
-        }
-
-        if (parser().attribute_present("hidden") && is_true(parser().attribute("hidden")))
-        {
-            row_properties.hidden = true;
-        }
+    const auto &parsed = streaming_batch_->parsed_cells[streaming_cell_index_++];
 
-        if (parser().attribute_present(qn("x14ac", "dyDescent")))
-        {
-            row_properties.dy_descent = converter_.deserialise(parser().attribute(qn("x14ac", "dyDescent")));
-        }
+    // the streaming cell is reused for every cell so hand its side table
+    // entry back to the worksheet instead of letting them accumulate
+    streaming_cell_->release_extras();
+    *streaming_cell_ = detail::cell_impl();
+    streaming_cell_->parent_ = current_worksheet_;
+    streaming_cell_->column_ = parsed.column;
+    streaming_cell_->row_ = parsed.row;
+    build_cell(parsed, *streaming_cell_);
 
-        if (parser().attribute_present("spans"))
-        {
-            row_properties.spans = parser().attribute("spans");
-        }
+    return cell(streaming_cell_.get());
+}
 
-        skip_attributes({"customFormat", "s", "customFont",
-            "outlineLevel", "collapsed", "thickTop", "thickBot",
-            "ph"});
-    }
+void xlsx_consumer::read_worksheet(const std::string &rel_id)
+{
+    read_worksheet_begin(rel_id);
 
-    if (!in_element(qn("spreadsheetml", "row")))
+    if (!streaming_)
     {
-        return cell(nullptr);
+        read_worksheet_sheetdata();
+        read_worksheet_end(rel_id);
     }
+}
 
-    expect_start_element(qn("spreadsheetml", "c"), xml::content::complex);
+void xlsx_consumer::read_worksheets(const std::vector<std::pair<relationship, worksheet_impl *>> &worksheets)
+{
+    const auto workbook_rel = manifest().relationship(path("/"), relationship_type::office_document);
 
-    auto cell = streaming_
-        ? xlnt::cell(streaming_cell_.get())
-        : ws.cell(cell_reference(parser().attribute("r")));
-    auto reference = cell_reference(parser().attribute("r"));
-    cell.d_->parent_ = current_worksheet_;
-    cell.d_->column_ = reference.column_index();
-    cell.d_->row_ = reference.row();
+    auto thread_count = options_.worksheet_threads == 0
+        ? static_cast<std::size_t>(std::thread::hardware_concurrency())
+        : options_.worksheet_threads;
+    thread_count = std::max(std::size_t(1), std::min(thread_count, worksheets.size()));
 
-    if (parser().attribute_present("ph"))
+    if (thread_count == 1)
     {
-        cell.d_->phonetics_visible_ = parser().attribute<bool>("ph");
-    }
+        for (const auto &worksheet : worksheets)
+        {
+            current_worksheet_ = worksheet.second;
+            read_part({workbook_rel, worksheet.first});
+        }
 
-    auto has_type = parser().attribute_present("t");
-    auto type = has_type ? parser().attribute("t") : "n";
+        return;
+    }
 
-    if (parser().attribute_present("s"))
+    // cells look up their formats by index while sheetData is read without the
+    // lock, so the index must already be built
+    if (target_.d_->stylesheet_.is_set())
     {
-        cell.format(target_.format(static_cast<std::size_t>(std::stoull(parser().attribute("s")))));
+        target_.d_->stylesheet_.get().refresh_format_index();
     }
 
-    auto has_value = false;
-    auto value_string = std::string();
+    std::mutex mutex;
+    std::atomic<std::size_t> next(0);
+    std::vector<std::exception_ptr> errors(worksheets.size());
 
-    auto has_formula = false;
-    auto has_shared_formula = false;
-    auto formula_value_string = std::string();
-
-    while (in_element(qn("spreadsheetml", "c")))
-    {
-        auto current_element = expect_start_element(xml::content::mixed);
+    auto work = [&]() {
+        xlsx_consumer worker(target_, options_);
+        worker.archive_ = archive_;
 
-        if (current_element == qn("spreadsheetml", "v")) // s:ST_Xstring
+        for (auto i = next++; i < worksheets.size(); i = next++)
         {
-            has_value = true;
-            value_string = read_text();
-        }
-        else if (current_element == qn("spreadsheetml", "f")) // CT_CellFormula
-        {
-            has_formula = true;
-
-            if (parser().attribute_present("t"))
+            try
             {
-                has_shared_formula = parser().attribute("t") == "shared";
+                worker.current_worksheet_ = worksheets[i].second;
+                worker.stack_.clear();
+                worker.read_worksheet_concurrently({workbook_rel, worksheets[i].first}, mutex);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
             }
-
-            skip_attributes({"aca", "ref", "dt2D", "dtr", "del1",
-                "del2", "r1", "r2", "ca", "si", "bx"});
-
-            formula_value_string = read_text();
-        }
-        else if (current_element == qn("spreadsheetml", "is")) // CT_Rst
-        {
-            expect_start_element(qn("spreadsheetml", "t"), xml::content::simple);
-            has_value = true;
-            value_string = read_text();
-            expect_end_element(qn("spreadsheetml", "t"));
-        }
-        else
-        {
-            unexpected_element(current_element);
         }
+    };
 
-        expect_end_element(current_element);
-    }
-
-    expect_end_element(qn("spreadsheetml", "c"));
+    std::vector<std::thread> threads;
 
-    if (has_formula && !has_shared_formula)
+    for (std::size_t i = 1; i < thread_count; ++i)
     {
-        cell.formula(formula_value_string);
+        threads.emplace_back(work);
     }
 
-    if (has_value)
+    work();
+
+    for (auto &thread : threads)
     {
-        if (type == "str")
-        {
-            cell.d_->value_text_ = value_string;
-            cell.data_type(cell::type::formula_string);
-        }
-        else if (type == "inlineStr")
-        {
-            cell.d_->value_text_ = value_string;
-            cell.data_type(cell::type::inline_string);
-        }
-        else if (type == "s")
-        {
-            cell.d_->value_numeric_ = converter_.deserialise(value_string);
-            cell.data_type(cell::type::shared_string);
-        }
-        else if (type == "b") // boolean
-        {
-            cell.value(is_true(value_string));
-        }
-        else if (type == "n") // numeric
-        {
-            cell.value(converter_.deserialise(value_string));
-        }
-        else if (!value_string.empty() && value_string[0] == '#')
-        {
-            cell.error(value_string);
-        }
+        thread.join();
     }
 
-    if (!in_element(qn("spreadsheetml", "row")))
+    // report the error of the first failing sheet, as a sequential read would
+    for (const auto &error : errors)
     {
-        expect_end_element(qn("spreadsheetml", "row"));
-
-        if (!in_element(qn("spreadsheetml", "sheetData")))
+        if (error)
         {
-            expect_end_element(qn("spreadsheetml", "sheetData"));
+            std::rethrow_exception(error);
         }
     }
-
-    return cell;
 }
 
-void xlsx_consumer::read_worksheet(const std::string &rel_id)
+void xlsx_consumer::read_worksheet_concurrently(const std::vector<relationship> &rel_chain, std::mutex &mutex)
 {
-    read_worksheet_begin(rel_id);
+    std::unique_lock<std::mutex> lock(mutex);
 
-    if (!streaming_)
-    {
-        read_worksheet_sheetdata();
-        read_worksheet_end(rel_id);
-    }
+    const auto part_path = manifest().canonicalize(rel_chain);
+    auto part_streambuf = archive_->open_detached(part_path);
+    sheet_data_splitter splitter(*part_streambuf, part_path.string());
+    sheet_data_ = &splitter;
+    std::istream part_stream(&splitter);
+    xml::parser parser(part_stream, part_path.string());
+    parser_ = &parser;
+
+    read_worksheet_begin(rel_chain.back().id());
+
+    lock.unlock();
+    read_worksheet_sheetdata();
+    lock.lock();
+
+    read_worksheet_end(rel_chain.back().id());
+
+    parser_ = nullptr;
+    sheet_data_ = nullptr;
 }
 
 std::string xlsx_consumer::read_worksheet_begin(const std::string &rel_id)
@@ -650,6 +494,10 @@ std::string xlsx_consumer::read_worksheet_begin(const std::string &rel_id)
         streaming_cell_.reset(new detail::cell_impl());
     }
 
+    streaming_batch_.reset();
+    streaming_scanner_.reset();
+    shared_formula_ids_.clear();
+
     auto title = std::find_if(target_.d_->sheet_title_rel_id_map_.begin(),
         target_.d_->sheet_title_rel_id_map_.end(),
         [&](const std::pair<std::string, std::string> &p) {
@@ -657,6 +505,8 @@ std::string xlsx_consumer::read_worksheet_begin(const std::string &rel_id)
         })->first;
 
     auto ws = worksheet(current_worksheet_);
+    const auto window = sheet_window(options_);
+    sheet_data_truncated_ = false;
 
     expect_start_element(qn("spreadsheetml", "worksheet"), xml::content::complex); // CT_Worksheet
     skip_attributes({qn("mc", "Ignorable")});
@@ -768,10 +618,15 @@ std::string xlsx_consumer::read_worksheet_begin(const std::string &rel_id)
                             : sheet_view_type::page_layout);
                 }
 
-                if (parser().attribute_present("tabSelected")
+                if (!reading_deferred_
+                    && parser().attribute_present("tabSelected")
                     && is_true(parser().attribute("tabSelected")))
                 {
-                    target_.d_->view_.get().active_tab = ws.id() - 1;
+                    // by position, which is what workbook_view::active_tab holds
+                    const auto &sheets = target_.d_->worksheets_;
+                    const auto position = std::find_if(sheets.begin(), sheets.end(),
+                        [this](const worksheet_impl &sheet) { return &sheet == current_worksheet_; });
+                    target_.d_->view_.get().active_tab = static_cast<std::size_t>(std::distance(sheets.begin(), position));
                 }
 
                 skip_attributes({"windowProtection", "showFormulas", "showRowColHeaders", "showZeros", "rightToLeft", "showRuler", "showOutlineSymbols", "showWhiteSpace",
@@ -924,7 +779,7 @@ std::string xlsx_consumer::read_worksheet_begin(const std::string &rel_id)
 
                 expect_end_element(qn("spreadsheetml", "col"));
 
-                for (auto column = min; column <= max; column++)
+                for (auto column = std::max(min, window.first_column); column <= std::min(max, window.last_column); column++)
                 {
                     column_properties props;
 
@@ -933,7 +788,7 @@ std::string xlsx_consumer::read_worksheet_begin(const std::string &rel_id)
                         props.width = width.get();
                     }
 
-                    if (column_style.is_set())
+                    if (column_style.is_set() && !options_.skip_styles)
                     {
                         props.style = column_style.get();
                     }
@@ -962,66 +817,262 @@ void xlsx_consumer::read_worksheet_sheetdata()
     {
         return;
     }
-    Sheet_Data ws_data = parse_sheet_data(parser_, converter_);
-    // NOTE: parse->construct are seperated here and could easily be threaded
-    // with a SPSC queue for what is likely to be an easy performance win
-    for (auto &row : ws_data.parsed_rows)
+
+    // an empty <sheetData/> is read by the parser like the rest of the part
+    if (sheet_data_ == nullptr || !sheet_data_->has_body())
     {
-        current_worksheet_->row_properties_.emplace(row.second, std::move(row.first));
+        expect_end_element(qn("spreadsheetml", "sheetData"));
+        return;
     }
-    auto impl = detail::cell_impl();
-    for (Cell &cell : ws_data.parsed_cells)
-    {
-        impl.parent_ = current_worksheet_;
-        impl.column_ = cell.ref.column;
-        impl.row_ = cell.ref.row;
-        detail::cell_impl *ws_cell_impl = &current_worksheet_->cell_map_.emplace(cell_reference(impl.column_, impl.row_), std::move(impl)).first->second;
-        if (cell.style_index != -1)
+
+    auto build = [this](sheet_data_batch &ws_data) {
+        add_rows(ws_data);
+        add_outside_shared_formulas(ws_data);
+        // size the cell pool and formula arena up front so that building the
+        // batch doesn't allocate per cell
+        auto formula_size = std::size_t(0);
+        if (!options_.skip_formulas)
         {
-            ws_cell_impl->format_ = target_.format(static_cast<size_t>(cell.style_index)).d_;
+            for (const parsed_cell &cell : ws_data.parsed_cells)
+            {
+                formula_size += cell.formula_string.size;
+            }
         }
-        if (cell.cell_metatdata_idx != -1)
+        current_worksheet_->cell_map_.reserve(ws_data.parsed_cells.size());
+        current_worksheet_->formulae_.reserve(formula_size);
+        for (const parsed_cell &cell : ws_data.parsed_cells)
         {
+            auto ws_cell_impl = current_worksheet_->cell_map_.emplace(cell.column, cell.row).first;
+            ws_cell_impl->parent_ = current_worksheet_;
+            build_cell(cell, *ws_cell_impl);
         }
-        ws_cell_impl->phonetics_visible_ = cell.is_phonetic;
-        if (!cell.formula_string.empty())
+    };
+
+    sheet_data_scanner scanner(*sheet_data_, sheet_window(options_));
+
+    // small sheets fit in the first batch and are read on this thread alone
+    auto batch = std::unique_ptr<sheet_data_batch>(new sheet_data_batch());
+
+    if (scanner.fill(*batch))
+    {
+        build(*batch);
+    }
+    else if (!options_.pipeline_worksheets)
+    {
+        do
         {
-            ws_cell_impl->formula_ = cell.formula_string[0] == '=' ? cell.formula_string.substr(1) : std::move(cell.formula_string);
-        }
-        if (!cell.value.empty())
+            build(*batch);
+        } while (!scanner.fill(*batch));
+
+        build(*batch);
+    }
+    else
+    {
+        // otherwise the remaining rows are inflated and scanned on a second thread
+        // while this one builds the cells, with a fixed number of batches passed
+        // back and forth
+        batch_queue scanned;
+        batch_queue recycled;
+
+        for (std::size_t i = 1; i < sheet_data_batch_count; ++i)
         {
-            ws_cell_impl->type_ = cell.type;
-            switch (cell.type)
+            recycled.push(std::unique_ptr<sheet_data_batch>(new sheet_data_batch()));
+        }
+
+        std::thread scanner_thread([&scanner, &scanned, &recycled]() {
+            for (auto next = recycled.pop(); next != nullptr; next = recycled.pop())
             {
-            case cell::type::boolean: {
-                ws_cell_impl->value_numeric_ = is_true(cell.value) ? 1.0 : 0.0;
-                break;
-            }
-            case cell::type::empty:
-            case cell::type::number:
-            case cell::type::date: {
-                ws_cell_impl->value_numeric_ = converter_.deserialise(cell.value);
-                break;
-            }
-            case cell::type::shared_string: {
-                ws_cell_impl->value_numeric_ = static_cast<double>(strtol(cell.value.c_str(), nullptr, 10));
-                break;
-            }
-            case cell::type::inline_string: {
-                ws_cell_impl->value_text_ = std::move(cell.value);
-                break;
-            }
-            case cell::type::formula_string: {
-                ws_cell_impl->value_text_ = std::move(cell.value);
-                break;
-            }
-            case cell::type::error: {
-                ws_cell_impl->value_text_.plain_text(cell.value, false);
-                break;
+                try
+                {
+                    scanner.fill(*next);
+                }
+                catch (...)
+                {
+                    next->error = std::current_exception();
+                    next->last = true;
+                }
+
+                const auto last = next->last;
+
+                if (!scanned.push(std::move(next)) || last)
+                {
+                    return;
+                }
             }
+        });
+
+        try
+        {
+            while (batch->error == nullptr)
+            {
+                build(*batch);
+
+                if (batch->last)
+                {
+                    break;
+                }
+
+                recycled.push(std::move(batch));
+                batch = scanned.pop();
             }
         }
+        catch (...)
+        {
+            scanned.close();
+            recycled.close();
+            scanner_thread.join();
+
+            throw;
+        }
+
+        scanner_thread.join();
+
+        if (batch->error != nullptr)
+        {
+            std::rethrow_exception(batch->error);
+        }
+    }
+
+    end_worksheet_sheetdata(batch->truncated);
+}
+
+void xlsx_consumer::add_rows(sheet_data_batch &batch)
+{
+    for (auto &row : batch.parsed_rows)
+    {
+        if (options_.skip_styles)
+        {
+            row.first.style.clear();
+            row.first.custom_format.clear();
+        }
+        current_worksheet_->row_properties_.emplace(row.second, std::move(row.first));
+    }
+}
+
+void xlsx_consumer::add_outside_shared_formulas(const sheet_data_batch &batch)
+{
+    if (options_.skip_formulas)
+    {
+        return;
+    }
+
+    for (const auto &cell : batch.outside_shared_formulas)
+    {
+        if (cell.shared_formula_index != -1)
+        {
+            add_shared_formula(cell);
+        }
+    }
+}
+
+void xlsx_consumer::build_cell(const parsed_cell &cell, detail::cell_impl &impl)
+{
+    if (cell.style_index != -1 && !options_.skip_styles)
+    {
+        impl.format_ = target_.format(static_cast<size_t>(cell.style_index)).d_;
+    }
+    impl.phonetics_visible_ = cell.is_phonetic;
+    if (cell.shared_formula && cell.shared_formula_index != -1 && !options_.skip_formulas)
+    {
+        build_shared_formula(cell, impl);
     }
+    else if (!cell.formula_string.empty() && !options_.skip_formulas)
+    {
+        const auto skip = cell.formula_string.data[0] == '=' ? std::size_t(1) : std::size_t(0);
+        impl.formula(cell.formula_string.data + skip, cell.formula_string.size - skip);
+    }
+    if (cell.value.empty())
+    {
+        return;
+    }
+    impl.type_ = cell.type;
+    switch (cell.type)
+    {
+    case cell::type::boolean: {
+        impl.value_numeric_ = is_true(cell.value.to_string()) ? 1.0 : 0.0;
+        break;
+    }
+    case cell::type::empty:
+    case cell::type::number:
+    case cell::type::date: {
+        impl.value_numeric_ = converter_.deserialise(cell.value.data, cell.value.size);
+        break;
+    }
+    case cell::type::shared_string: {
+        impl.value_numeric_ = parse_index(cell.value);
+        break;
+    }
+    case cell::type::inline_string: {
+        impl.extras().value_text_ = cell.value.to_string();
+        break;
+    }
+    case cell::type::formula_string: {
+        impl.extras().value_text_ = cell.value.to_string();
+        break;
+    }
+    case cell::type::error: {
+        impl.extras().value_text_.plain_text(cell.value.to_string(), false);
+        break;
+    }
+    }
+}
+
+void xlsx_consumer::build_shared_formula(const parsed_cell &cell, detail::cell_impl &impl)
+{
+    // the first cell of a group holds the formula text, the rest only refer to it
+    if (!cell.formula_string.empty())
+    {
+        impl.shared_formula_ = add_shared_formula(cell);
+        return;
+    }
+
+    auto id = shared_formula_ids_.find(cell.shared_formula_index);
+
+    if (id != shared_formula_ids_.end())
+    {
+        impl.shared_formula_ = id->second;
+    }
+}
+
+std::uint32_t xlsx_consumer::add_shared_formula(const parsed_cell &cell)
+{
+    auto &shared_formulas = current_worksheet_->shared_formulas_;
+    const auto skip = cell.formula_string.data[0] == '=' ? std::size_t(1) : std::size_t(0);
+    const auto position = cell_reference(cell.column, cell.row);
+
+    shared_formula formula;
+    formula.column = cell.column;
+    formula.row = cell.row;
+    formula.formula.assign(cell.formula_string.data + skip, cell.formula_string.size - skip);
+    formula.range = cell.shared_formula_ref.empty()
+        ? range_reference(position, position)
+        : range_reference(cell.shared_formula_ref.to_string());
+
+    shared_formulas.push_back(std::move(formula));
+    const auto id = static_cast<std::uint32_t>(shared_formulas.size());
+    shared_formula_ids_[cell.shared_formula_index] = id;
+
+    return id;
+}
+
+void xlsx_consumer::end_worksheet_sheetdata(bool truncated)
+{
+    if (truncated)
+    {
+        // nothing after the window is read, so the worksheet ends here
+        sheet_data_truncated_ = true;
+        stack_.pop_back();
+        stack_.pop_back();
+
+        return;
+    }
+
+    // the rest of the part is read by a new parser, starting with a copy of the
+    // worksheet start tag
+    parser_ = &sheet_data_->tail();
+    parser().next_expect(xml::parser::event_type::start_element, qn("spreadsheetml", "worksheet"));
+    parser().content(xml::content::complex);
+    skip_attributes();
     stack_.pop_back();
 }
 
@@ -1034,9 +1085,42 @@ worksheet xlsx_consumer::read_worksheet_end(const std::string &rel_id)
     path sheet_path(sheet_rel.source().path().parent().append(sheet_rel.target().path()));
     auto hyperlinks = manifest.relationships(sheet_path, xlnt::relationship_type::hyperlink);
 
+    // parts that aren't wanted are removed from the package so that they are neither
+    // read nor saved empty later. This renumbers the relationships of the sheet, so
+    // the hyperlinks above keep the ids used in the part and are matched to their
+    // new relationships by target
+    auto drop = [&](relationship_type type) {
+        if (!manifest.has_relationship(sheet_path, type)) return;
+
+        const auto rel = manifest.relationship(sheet_path, type);
+        manifest.unregister_override_type(manifest.canonicalize({workbook_rel, sheet_rel, rel}).resolve(path("/")));
+        manifest.unregister_relationship(uri(sheet_path.string()), rel.id());
+    };
+
+    if (options_.skip_comments)
+    {
+        drop(relationship_type::comments);
+        drop(relationship_type::vml_drawing);
+    }
+
+    if (options_.skip_drawings)
+    {
+        drop(relationship_type::drawings);
+    }
+
+    if (streaming_)
+    {
+        // cells that weren't asked for are skipped to get to the rest of the part
+        while (has_cell())
+        {
+            streaming_cell_index_ = streaming_batch_->parsed_cells.size();
+        }
+    }
+
     auto ws = worksheet(current_worksheet_);
+    const auto window = sheet_window(options_);
 
-    while (in_element(qn("spreadsheetml", "worksheet")))
+    while (!sheet_data_truncated_ && in_element(qn("spreadsheetml", "worksheet")))
     {
         auto current_worksheet_element = expect_start_element(xml::content::complex);
 
@@ -1081,7 +1165,13 @@ worksheet xlsx_consumer::read_worksheet_end(const std::string &rel_id)
             while (in_element(qn("spreadsheetml", "mergeCells")))
             {
                 expect_start_element(qn("spreadsheetml", "mergeCell"), xml::content::simple);
-                ws.merge_cells(range_reference(parser().attribute("ref")));
+                const auto merged = range_reference(parser().attribute("ref"));
+
+                if (window.contains(merged.top_left().column_index(), merged.top_left().row()))
+                {
+                    ws.merge_cells(merged);
+                }
+
                 expect_end_element(qn("spreadsheetml", "mergeCell"));
 
                 count--;
@@ -1120,7 +1210,17 @@ worksheet xlsx_consumer::read_worksheet_end(const std::string &rel_id)
                 // CT_Hyperlink
                 expect_start_element(qn("spreadsheetml", "hyperlink"), xml::content::simple);
 
-                auto cell = ws.cell(parser().attribute("ref"));
+                const auto reference = cell_reference(parser().attribute("ref"));
+
+                if (!window.contains(reference.column_index(), reference.row()))
+                {
+                    skip_attributes();
+                    expect_end_element(qn("spreadsheetml", "hyperlink"));
+
+                    continue;
+                }
+
+                auto cell = ws.cell(reference);
 
                 if (parser().attribute_present(qn("r", "id")))
                 {
@@ -1160,7 +1260,7 @@ worksheet xlsx_consumer::read_worksheet_end(const std::string &rel_id)
                         hyperlink.tooltip = parser().attribute("tooltip");
                     }
 
-                    cell.d_->hyperlink_ = hyperlink;
+                    cell.d_->hyperlink() = hyperlink;
                 }
 
                 expect_end_element(qn("spreadsheetml", "hyperlink"));
@@ -1417,7 +1517,10 @@ worksheet xlsx_consumer::read_worksheet_end(const std::string &rel_id)
         expect_end_element(current_worksheet_element);
     }
 
-    expect_end_element(qn("spreadsheetml", "worksheet"));
+    if (!sheet_data_truncated_)
+    {
+        expect_end_element(qn("spreadsheetml", "worksheet"));
+    }
 
     if (manifest.has_relationship(sheet_path, xlnt::relationship_type::comments))
     {
@@ -1470,8 +1573,144 @@ xml::parser &xlsx_consumer::parser()
 
 bool xlsx_consumer::has_cell()
 {
-    return in_element(qn("spreadsheetml", "row"))
-        || in_element(qn("spreadsheetml", "sheetData"));
+    while (streaming_batch_ == nullptr || streaming_cell_index_ == streaming_batch_->parsed_cells.size())
+    {
+        if (!next_streaming_batch())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool xlsx_consumer::read_row(row_buffer &buffer)
+{
+    do
+    {
+        while (streaming_batch_ == nullptr || streaming_row_index_ == streaming_batch_->parsed_rows.size())
+        {
+            if (!next_streaming_batch())
+            {
+                return false;
+            }
+        }
+
+        skip_rows_read_by_cell();
+    } while (streaming_row_index_ == streaming_batch_->parsed_rows.size());
+
+    const auto row = streaming_batch_->parsed_rows[streaming_row_index_++].second;
+    const auto &cells = streaming_batch_->parsed_cells;
+    buffer.last_row = row;
+
+    for (; streaming_cell_index_ < cells.size() && cells[streaming_cell_index_].row == row; ++streaming_cell_index_)
+    {
+        const auto &cell = cells[streaming_cell_index_];
+        auto type = cell.value.empty() ? cell::type::empty : cell.type;
+        auto number = 0.0;
+        auto shared_string = std::size_t(0);
+        auto text = string_slice();
+
+        switch (type)
+        {
+        case cell::type::boolean:
+            number = is_true(cell.value.to_string()) ? 1.0 : 0.0;
+            break;
+        case cell::type::number:
+        case cell::type::date:
+            number = converter_.deserialise(cell.value.data, cell.value.size);
+            break;
+        case cell::type::shared_string:
+            shared_string = static_cast<std::size_t>(parse_index(cell.value));
+            break;
+        case cell::type::inline_string:
+        case cell::type::formula_string:
+        case cell::type::error:
+            text = cell.value;
+            break;
+        case cell::type::empty:
+            break;
+        }
+
+        buffer.rows.push_back(row);
+        buffer.columns.push_back(cell.column);
+        buffer.types.push_back(type);
+        buffer.numbers.push_back(number);
+        buffer.shared_strings.push_back(shared_string);
+        buffer.formats.push_back(cell.style_index != -1 && !options_.skip_styles
+                ? optional<std::size_t>(static_cast<std::size_t>(cell.style_index))
+                : optional<std::size_t>());
+        buffer.text_offsets.push_back(buffer.characters.size());
+        buffer.text_sizes.push_back(text.size);
+
+        if (!text.empty())
+        {
+            buffer.characters.append(text.data, text.size);
+        }
+    }
+
+    return true;
+}
+
+void xlsx_consumer::skip_rows_read_by_cell()
+{
+    // read_cell() only moves through the cells, so the rows before the one it
+    // is in are skipped here, as is that one if read_cell() has read all of it
+    if (streaming_cell_index_ == 0)
+    {
+        return;
+    }
+
+    const auto &rows = streaming_batch_->parsed_rows;
+    const auto &cells = streaming_batch_->parsed_cells;
+    const auto last_read = cells[streaming_cell_index_ - 1].row;
+    const auto row_finished = streaming_cell_index_ == cells.size() || cells[streaming_cell_index_].row != last_read;
+
+    while (streaming_row_index_ < rows.size()
+        && (rows[streaming_row_index_].second < last_read
+            || (rows[streaming_row_index_].second == last_read && row_finished)))
+    {
+        ++streaming_row_index_;
+    }
+}
+
+bool xlsx_consumer::next_streaming_batch()
+{
+    if (streaming_batch_ == nullptr)
+    {
+        if (stack_.empty() || stack_.back() != qn("spreadsheetml", "sheetData"))
+        {
+            return false;
+        }
+
+        if (!sheet_data_->has_body())
+        {
+            expect_end_element(qn("spreadsheetml", "sheetData"));
+            return false;
+        }
+
+        // sheetData is scanned a batch at a time as its cells are asked for,
+        // so only one batch is held however large the worksheet is
+        streaming_scanner_.reset(new sheet_data_scanner(*sheet_data_, sheet_window(options_)));
+        streaming_batch_.reset(new sheet_data_batch());
+    }
+    else if (streaming_batch_->last)
+    {
+        const auto truncated = streaming_batch_->truncated;
+        streaming_batch_.reset();
+        streaming_scanner_.reset();
+        end_worksheet_sheetdata(truncated);
+
+        return false;
+    }
+
+    streaming_scanner_->fill(*streaming_batch_);
+    streaming_cell_index_ = 0;
+    streaming_row_index_ = 0;
+    add_rows(*streaming_batch_);
+    add_outside_shared_formulas(*streaming_batch_);
+
+    return true;
 }
 
 std::vector<relationship> xlsx_consumer::read_relationships(const path &part)
@@ -1520,7 +1759,17 @@ void xlsx_consumer::read_part(const std::vector<relationship> &rel_chain)
     const auto &manifest = target_.manifest();
     const auto part_path = manifest.canonicalize(rel_chain);
     auto part_streambuf = archive_->open(part_path);
-    std::istream part_stream(part_streambuf.get());
+
+    // sheetData is left to a sheet_data_scanner, see read_worksheet_sheetdata
+    std::unique_ptr<sheet_data_splitter> splitter;
+
+    if (rel_chain.back().type() == relationship_type::worksheet && !streaming_)
+    {
+        splitter.reset(new sheet_data_splitter(*part_streambuf, part_path.string()));
+    }
+
+    sheet_data_ = splitter.get();
+    std::istream part_stream(splitter != nullptr ? splitter.get() : part_streambuf.get());
     xml::parser parser(part_stream, part_path.string());
     parser_ = &parser;
 
@@ -1649,6 +1898,7 @@ void xlsx_consumer::read_part(const std::vector<relationship> &rel_chain)
     }
 
     parser_ = nullptr;
+    sheet_data_ = nullptr;
 }
 
 void xlsx_consumer::populate_workbook(bool streaming)
@@ -2054,20 +2304,66 @@ void xlsx_consumer::read_office_document(const std::string &content_type) // CT_
                 relationship_type::shared_string_table)});
     }
 
-    if (manifest().has_relationship(workbook_path, relationship_type::stylesheet))
+    if (options_.skip_styles)
+    {
+        // cells are read without formats, but the workbook gets the stylesheet of
+        // a new workbook so that it can still be formatted and saved
+        auto blank = workbook::empty();
+        target_.d_->stylesheet_ = blank.d_->stylesheet_;
+
+        auto &stylesheet = target_.d_->stylesheet_.get();
+        stylesheet.parent = &target_;
+
+        for (auto &format : stylesheet.format_impls)
+        {
+            format.parent = &stylesheet;
+        }
+
+        for (auto &style : stylesheet.style_impls)
+        {
+            style.second.parent = &stylesheet;
+        }
+    }
+    else if (manifest().has_relationship(workbook_path, relationship_type::stylesheet))
     {
         read_part({workbook_rel,
             manifest().relationship(workbook_path,
                 relationship_type::stylesheet)});
     }
 
-    if (manifest().has_relationship(workbook_path, relationship_type::theme))
+    if (manifest().has_relationship(workbook_path, relationship_type::theme) && !options_.skip_styles)
     {
         read_part({workbook_rel,
             manifest().relationship(workbook_path,
                 relationship_type::theme)});
     }
 
+    for (const auto &title : options_.sheet_titles)
+    {
+        if (sheet_title_index_map_.find(title) == sheet_title_index_map_.end())
+        {
+            throw key_not_found();
+        }
+    }
+
+    for (auto index : options_.sheet_indices)
+    {
+        if (index >= sheet_title_index_map_.size())
+        {
+            throw key_not_found();
+        }
+    }
+
+    const auto read_all = options_.sheet_titles.empty() && options_.sheet_indices.empty();
+    auto selected = [&](const std::string &title, std::size_t index) {
+        return read_all
+            || std::find(options_.sheet_titles.begin(), options_.sheet_titles.end(), title) != options_.sheet_titles.end()
+            || std::find(options_.sheet_indices.begin(), options_.sheet_indices.end(), index) != options_.sheet_indices.end();
+    };
+
+    std::vector<std::pair<relationship, worksheet_impl *>> worksheets;
+    std::vector<worksheet_impl *> unselected;
+
     for (auto worksheet_rel : manifest().relationships(workbook_path, relationship_type::worksheet))
     {
         auto title = std::find_if(target_.d_->sheet_title_rel_id_map_.begin(),
@@ -2088,11 +2384,62 @@ void xlsx_consumer::read_office_document(const std::string &content_type) // CT_
 
         current_worksheet_ = &*target_.d_->worksheets_.emplace(insertion_iter, &target_, id, title);
 
-        if (!streaming_)
+        if (!selected(title, index))
+        {
+            unselected.push_back(current_worksheet_);
+        }
+        else if (options_.lazy_worksheets && !streaming_)
+        {
+            current_worksheet_->deferred_ = true;
+        }
+        else if (!streaming_)
         {
-            read_part({workbook_rel, worksheet_rel});
+            worksheets.emplace_back(worksheet_rel, current_worksheet_);
         }
     }
+
+    const auto &sheets = target_.d_->worksheets_;
+
+    if (std::any_of(sheets.begin(), sheets.end(), [](const worksheet_impl &ws) { return ws.deferred_; }))
+    {
+        target_.d_->deferred_archive_ = archive_;
+        target_.d_->deferred_options_ = options_;
+    }
+
+    read_worksheets(worksheets);
+
+    if (unselected.empty())
+    {
+        return;
+    }
+
+    // the active tab is a position, so it has to follow its sheet
+    const worksheet_impl *active = nullptr;
+
+    if (target_.has_view() && target_.view().active_tab.is_set()
+        && target_.view().active_tab.get() < sheets.size())
+    {
+        active = &*std::next(sheets.begin(), static_cast<std::ptrdiff_t>(target_.view().active_tab.get()));
+    }
+
+    // worksheets that weren't selected are never inflated and are removed along
+    // with their relationships afterwards, since that renumbers the relationship
+    // ids the others were read by
+    for (auto ws : unselected)
+    {
+        target_.remove_sheet(worksheet(ws));
+    }
+
+    if (target_.has_view() && target_.view().active_tab.is_set())
+    {
+        auto position = std::find_if(sheets.begin(), sheets.end(),
+            [active](const worksheet_impl &ws) { return &ws == active; });
+        auto view = target_.view();
+        view.active_tab = position == sheets.end()
+            ? std::size_t(0)
+            : static_cast<std::size_t>(std::distance(sheets.begin(), position));
+        target_.view(view);
+    }
 }
 
 // Write Workbook Relationship Target Parts
@@ -2141,6 +2488,7 @@ void xlsx_consumer::read_shared_string_table()
     {
         has_unique_count = true;
         unique_count = parser().attribute<std::size_t>("uniqueCount");
+        target_.d_->shared_strings_.reserve(unique_count);
     }
 
     while (in_element(qn("spreadsheetml", "sst")))
@@ -2875,6 +3223,7 @@ void xlsx_consumer::read_vml_drawings(worksheet /*ws*/)
 void xlsx_consumer::read_comments(worksheet ws)
 {
     std::vector<std::string> authors;
+    const auto window = sheet_window(options_);
 
     expect_start_element(qn("spreadsheetml", "comments"), xml::content::complex);
     // name space can be ignored
@@ -2896,12 +3245,17 @@ void xlsx_consumer::read_comments(worksheet ws)
         expect_start_element(qn("spreadsheetml", "comment"), xml::content::complex);
 
         skip_attribute("shapeId");
-        auto cell_ref = parser().attribute("ref");
+        auto cell_ref = cell_reference(parser().attribute("ref"));
         auto author_id = parser().attribute<std::size_t>("authorId");
 
         expect_start_element(qn("spreadsheetml", "text"), xml::content::complex);
 
-        ws.cell(cell_ref).comment(comment(read_rich_text(qn("spreadsheetml", "text")), authors.at(author_id)));
+        auto text = read_rich_text(qn("spreadsheetml", "text"));
+
+        if (window.contains(cell_ref.column_index(), cell_ref.row()))
+        {
+            ws.cell(cell_ref).comment(comment(text, authors.at(author_id)));
+        }
 
         expect_end_element(qn("spreadsheetml", "text"));
 
@@ -28,13 +28,16 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <detail/external/include_libstudxml.hpp>
 #include <detail/serialization/zstream.hpp>
 #include <xlnt/utils/numeric.hpp>
+#include <xlnt/workbook/load_options.hpp>
 
 namespace xlnt {
 
@@ -46,6 +49,7 @@ template<typename T>
 class optional;
 class path;
 class relationship;
+class row_buffer;
 class streaming_workbook_reader;
 class variant;
 class workbook;
@@ -54,7 +58,11 @@ class worksheet;
 namespace detail {
 
 class izstream;
+class sheet_data_scanner;
+class sheet_data_splitter;
 struct cell_impl;
+struct parsed_cell;
+struct sheet_data_batch;
 struct worksheet_impl;
 
 /// <summary>
@@ -65,26 +73,59 @@ class xlsx_consumer
 public:
 	xlsx_consumer(workbook &destination);
 
+	xlsx_consumer(workbook &destination, const load_options &options);
+
 	~xlsx_consumer();
 
 	void read(std::istream &source);
 
 	void read(std::istream &source, const std::string &password);
 
+    /// <summary>
+    /// Reads worksheet, which a lazy load of target left unread, from the package
+    /// target kept for it.
+    /// </summary>
+    static void read_deferred_worksheet(workbook &target, worksheet_impl &worksheet);
+
 private:
     friend class xlnt::streaming_workbook_reader;
 
     void open(std::istream &source);
 
+    /// <summary>
+    /// Returns true if the current worksheet has a cell left to be read by
+    /// read_cell(). Once it returns false the rest of the worksheet part can
+    /// be read by read_worksheet_end().
+    /// </summary>
     bool has_cell();
 
     /// <summary>
-    /// Reads the next cell in the current worksheet and optionally returns it if
-    /// the last cell in the sheet has not yet been read. An exception will be thrown
-    /// if this is not open as a streaming consumer.
+    /// Reads the next cell in the current worksheet and returns it, or a null
+    /// cell if the last cell in the sheet has already been read. The returned
+    /// cell is only valid until the next call. This must be open as a
+    /// streaming consumer.
     /// </summary>
     cell read_cell();
 
+    /// <summary>
+    /// Appends the cells of the next row in the current worksheet, or what is left
+    /// of it after read_cell(), to buffer. Returns false if every row has been read.
+    /// </summary>
+    bool read_row(row_buffer &buffer);
+
+    /// <summary>
+    /// Moves the next row to be read by read_row() past the rows whose cells
+    /// read_cell() has already read.
+    /// </summary>
+    void skip_rows_read_by_cell();
+
+    /// <summary>
+    /// Scans the next batch of the current worksheet's sheetData, starting the
+    /// scan if it hasn't been. Returns false, leaving the parser after sheetData,
+    /// once there is nothing left to scan.
+    /// </summary>
+    bool next_streaming_batch();
+
 	/// <summary>
 	/// Read all the files needed from the XLSX archive and initialize all of
 	/// the data in the workbook to match.
@@ -203,6 +244,18 @@ private:
 	/// </summary>
 	void read_worksheet(const std::string &rel_id);
 
+    /// <summary>
+    /// Reads the given worksheet parts into their (already created) worksheets,
+    /// concurrently if options_ allows it.
+    /// </summary>
+    void read_worksheets(const std::vector<std::pair<relationship, worksheet_impl *>> &worksheets);
+
+    /// <summary>
+    /// Reads a worksheet part on a worker thread. Only sheetData is read without
+    /// holding mutex since everything else may touch the shared workbook.
+    /// </summary>
+    void read_worksheet_concurrently(const std::vector<relationship> &rel_chain, std::mutex &mutex);
+
     /// <summary>
     /// xl/sheets/*.xml
     /// </summary>
@@ -213,6 +266,40 @@ private:
     /// </summary>
     void read_worksheet_sheetdata();
 
+    /// <summary>
+    /// Stores the row properties of batch in the current worksheet.
+    /// </summary>
+    void add_rows(sheet_data_batch &batch);
+
+    /// <summary>
+    /// Stores the shared formulas of batch whose text is held by a cell outside
+    /// of the window, for the rest of their group to refer to.
+    /// </summary>
+    void add_outside_shared_formulas(const sheet_data_batch &batch);
+
+    /// <summary>
+    /// Sets the value, formula and format of impl to those of cell.
+    /// </summary>
+    void build_cell(const parsed_cell &cell, detail::cell_impl &impl);
+
+    /// <summary>
+    /// Adds the formula of a cell that is part of a shared formula, storing the
+    /// formula text once for its group and making impl refer to it.
+    /// </summary>
+    void build_shared_formula(const parsed_cell &cell, detail::cell_impl &impl);
+
+    /// <summary>
+    /// Stores the shared formula whose text cell holds and returns the value of
+    /// cell_impl::shared_formula_ for the cells of its group.
+    /// </summary>
+    std::uint32_t add_shared_formula(const parsed_cell &cell);
+
+    /// <summary>
+    /// Leaves sheetData once its body has been scanned, handing the rest of the
+    /// part to the parser unless the scan was truncated at the end of the window.
+    /// </summary>
+    void end_worksheet_sheetdata(bool truncated);
+
     /// <summary>
     /// xl/sheets/*.xml
     /// </summary>
@@ -379,8 +466,9 @@ private:
 
 	/// <summary>
 	/// The ZIP file containing the files that make up the OOXML package.
+	/// Shared with the consumers reading worksheets on other threads.
 	/// </summary>
-	std::unique_ptr<izstream> archive_;
+	std::shared_ptr<izstream> archive_;
 
 	/// <summary>
 	/// Map of sheet titles to relationship IDs.
@@ -405,6 +493,18 @@ private:
 	/// </summary>
 	xml::parser *parser_;
 
+    /// <summary>
+    /// The worksheet part being read, split so that its sheetData can be
+    /// scanned directly, or nullptr when parser_ reads the whole part.
+    /// </summary>
+    sheet_data_splitter *sheet_data_ = nullptr;
+
+    /// <summary>
+    /// True if sheetData was left at the end of the row window, in which case
+    /// the rest of the worksheet part is never read.
+    /// </summary>
+    bool sheet_data_truncated_ = false;
+
     std::vector<xml::qname> stack_;
 
     bool preserve_space_ = false;
@@ -413,10 +513,34 @@ private:
 
     std::unique_ptr<detail::cell_impl> streaming_cell_;
 
+    /// <summary>
+    /// The scanner reading the current worksheet's sheetData while streaming,
+    /// the batch it last filled and the positions of the next cell and row in that batch.
+    /// </summary>
+    std::unique_ptr<sheet_data_scanner> streaming_scanner_;
+    std::unique_ptr<sheet_data_batch> streaming_batch_;
+    std::size_t streaming_cell_index_ = 0;
+    std::size_t streaming_row_index_ = 0;
+
+    /// <summary>
+    /// Maps the si attribute of each shared formula in the current worksheet to
+    /// the value of cell_impl::shared_formula_ given to the cells of its group.
+    /// </summary>
+    std::unordered_map<int, std::uint32_t> shared_formula_ids_;
+
     detail::cell_impl *current_cell_;
 
     detail::worksheet_impl *current_worksheet_;
+
+    /// <summary>
+    /// True when a deferred worksheet is being read after load, in which case
+    /// the workbook view, which the caller may since have changed, is left alone.
+    /// </summary>
+    bool reading_deferred_ = false;
+
     number_serialiser converter_;
+
+    load_options options_;
 };
 
 } // namespace detail
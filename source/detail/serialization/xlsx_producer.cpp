@@ -21,6 +21,7 @@
 // @license: http://www.opensource.org/licenses/mit-license.php
 // @author: see AUTHORS file
 
+#include <algorithm>
 #include <cmath>
 #include <numeric> // for std::accumulate
 #include <string>
@@ -38,6 +39,7 @@
 #include <xlnt/worksheet/worksheet.hpp>
 #include <detail/constants.hpp>
 #include <detail/header_footer/header_footer_code.hpp>
+#include <detail/implementations/spilled_string_table.hpp>
 #include <detail/implementations/workbook_impl.hpp>
 #include <detail/serialization/custom_value_traits.hpp>
 #include <detail/serialization/vector_streambuf.hpp>
@@ -99,21 +101,227 @@ void xlsx_producer::write(std::ostream &destination)
 void xlsx_producer::open(std::ostream &destination)
 {
     archive_.reset(new ozstream(destination));
+    streaming_ = true;
+    streaming_cell_.reset(new cell_impl());
+}
+
+void xlsx_producer::close()
+{
+    end_worksheet();
     populate_archive(true);
+    archive_.reset();
+}
+
+void xlsx_producer::begin_worksheet(worksheet ws)
+{
+    static const auto &xmlns = constants::ns("spreadsheetml");
+
+    end_worksheet();
+
+    const auto workbook_rel = source_.manifest().relationship(path("/"), relationship_type::office_document);
+    const auto sheet_rel = source_.manifest().relationship(workbook_rel.target().path(),
+        source_.d_->sheet_title_rel_id_map_.at(ws.title()));
+    begin_part(sheet_rel.source().path().parent().append(sheet_rel.target().path()));
+
+    // only sheetData is written, every other element of a worksheet being optional
+    write_start_element(xmlns, "worksheet");
+    write_namespace(xmlns, "");
+    write_namespace(constants::ns("r"), "r");
+    write_start_element(xmlns, "sheetData");
+
+    current_worksheet_ = ws.d_;
+    *streaming_cell_ = cell_impl();
+    streaming_cell_->parent_ = current_worksheet_;
+    streaming_cell_pending_ = false;
+    streaming_format_ = nullptr;
+    streaming_row_ = 0;
+    streaming_column_ = 0;
+    streaming_row_open_ = false;
+    ++streamed_worksheets_;
+}
+
+void xlsx_producer::end_worksheet()
+{
+    static const auto &xmlns = constants::ns("spreadsheetml");
+
+    if (current_worksheet_ == nullptr) return;
+
+    write_pending_cell();
+
+    if (streaming_row_open_)
+    {
+        write_end_element(xmlns, "row");
+        streaming_row_open_ = false;
+    }
+
+    write_end_element(xmlns, "sheetData");
+    write_end_element(xmlns, "worksheet");
+    end_part();
+
+    current_worksheet_ = nullptr;
 }
 
 cell xlsx_producer::add_cell(const cell_reference &ref)
 {
-    current_cell_->column_ = ref.column();
-    current_cell_->row_ = ref.row();
+    static const auto &xmlns = constants::ns("spreadsheetml");
+
+    if (current_worksheet_ == nullptr)
+    {
+        begin_worksheet(source_.sheet_by_index(0));
+    }
+
+    write_pending_cell();
+
+    const auto row = ref.row();
+    const auto column = ref.column_index();
+
+    if (row < streaming_row_ || (row == streaming_row_ && column <= streaming_column_))
+    {
+        throw invalid_parameter();
+    }
+
+    if (streaming_row_open_ && row != streaming_row_)
+    {
+        write_end_element(xmlns, "row");
+        streaming_row_open_ = false;
+    }
+
+    if (!streaming_row_open_)
+    {
+        write_start_element(xmlns, "row");
+        write_attribute("r", row);
+        streaming_row_open_ = true;
+    }
+
+    streaming_row_ = row;
+    streaming_column_ = column;
+
+    streaming_cell_->column_ = column;
+    streaming_cell_->row_ = row;
+    streaming_cell_pending_ = true;
 
-    return cell(current_cell_);
+    return cell(streaming_cell_.get());
 }
 
-worksheet xlsx_producer::add_worksheet(const std::string &title)
+void xlsx_producer::add_row()
 {
-    current_worksheet_->title_ = title;
-    return worksheet(current_worksheet_);
+    static const auto &xmlns = constants::ns("spreadsheetml");
+
+    if (current_worksheet_ == nullptr)
+    {
+        begin_worksheet(source_.sheet_by_index(0));
+    }
+
+    write_pending_cell();
+
+    if (streaming_row_open_)
+    {
+        write_end_element(xmlns, "row");
+        streaming_row_open_ = false;
+    }
+
+    ++streaming_row_;
+    streaming_column_ = 0;
+    streaming_format_ = nullptr;
+}
+
+cell xlsx_producer::append_cell()
+{
+    if (current_worksheet_ == nullptr || streaming_row_ == 0)
+    {
+        add_row();
+    }
+
+    auto result = add_cell(cell_reference(streaming_column_ + 1, streaming_row_));
+
+    if (streaming_format_ != nullptr)
+    {
+        result.format(xlnt::format(streaming_format_));
+    }
+
+    return result;
+}
+
+void xlsx_producer::append_format(const format &row_format)
+{
+    streaming_format_ = row_format.d_;
+}
+
+void xlsx_producer::append_string(const std::string &text)
+{
+    auto result = append_cell();
+
+    if (spilled_strings_)
+    {
+        streaming_cell_->type_ = cell_type::shared_string;
+        streaming_cell_->value_numeric_ = static_cast<double>(spilled_strings_->add(result.check_string(text)));
+        streaming_cell_spilled_ = true;
+
+        return;
+    }
+
+    // written inline so that nothing is kept once the cell has been written
+    streaming_cell_->type_ = cell_type::inline_string;
+    streaming_cell_->extras().value_text_.plain_text(result.check_string(text), false);
+}
+
+void xlsx_producer::spill_shared_strings()
+{
+    if (spilled_strings_) return;
+
+    // strings already in the workbook's table may have been written by index
+    if (source_.d_->shared_strings_.size() != 0)
+    {
+        throw invalid_parameter();
+    }
+
+    spilled_strings_.reset(new spilled_string_table());
+}
+
+void xlsx_producer::write_pending_cell()
+{
+    if (!streaming_cell_pending_) return;
+
+    streaming_cell_pending_ = false;
+
+    // a string given to the cell itself went to the workbook's shared strings,
+    // from where it is moved to the spilled table, or written inline if it has
+    // formatted runs, so that the workbook's table never holds more than one string
+    if (spilled_strings_ && streaming_cell_->type_ == cell_type::shared_string && !streaming_cell_spilled_)
+    {
+        auto &workbook_strings = source_.d_->shared_strings_;
+        const auto &text = workbook_strings[static_cast<std::size_t>(streaming_cell_->value_numeric_)];
+        const auto runs = text.runs();
+
+        if (runs.size() == 1 && !runs.front().second.is_set())
+        {
+            streaming_cell_->value_numeric_ = static_cast<double>(spilled_strings_->add(runs.front().first));
+        }
+        else
+        {
+            streaming_cell_->type_ = cell_type::inline_string;
+            streaming_cell_->extras().value_text_ = text;
+        }
+
+        workbook_strings.clear();
+    }
+
+    if (!streaming_cell_->is_garbage_collectible())
+    {
+        if (spilled_strings_ && streaming_cell_->type_ == cell_type::shared_string)
+        {
+            ++spilled_string_cells_;
+        }
+
+        write_cell(cell(streaming_cell_.get()));
+    }
+
+    streaming_cell_spilled_ = false;
+
+    // hand the side table entry back to the worksheet so that they don't accumulate
+    streaming_cell_->release_extras();
+    *streaming_cell_ = cell_impl();
+    streaming_cell_->parent_ = current_worksheet_;
 }
 
 // Part Writing Methods
@@ -668,6 +876,9 @@ void xlsx_producer::write_workbook(const relationship &rel)
     {
         if (child_rel.type() == relationship_type::calculation_chain) continue;
 
+        // streamed worksheets are already in the archive
+        if (streaming_ && child_rel.type() == relationship_type::worksheet) continue;
+
         path archive_path(child_rel.source().path().parent().append(child_rel.target().path()));
         begin_part(archive_path);
 
@@ -809,15 +1020,17 @@ void xlsx_producer::write_pivot_table(const relationship & /*rel*/)
 
 void xlsx_producer::write_rich_text(const std::string &ns, const xlnt::rich_text &text)
 {
-    if (text.runs().size() == 1 && !text.runs().at(0).second.is_set())
+    const auto runs = text.runs();
+
+    if (runs.size() == 1 && !runs.front().second.is_set())
     {
         write_start_element(ns, "t");
-        write_characters(text.plain_text(), text.runs().front().preserve_space);
+        write_characters(runs.front().first, runs.front().preserve_space);
         write_end_element(ns, "t");
     }
     else
     {
-        for (const auto &run : text.runs())
+        for (const auto &run : runs)
         {
             write_start_element(ns, "r");
 
@@ -915,6 +1128,22 @@ void xlsx_producer::write_shared_string_table(const relationship & /*rel*/)
     write_start_element(xmlns, "sst");
     write_namespace(xmlns, "");
 
+    if (spilled_strings_)
+    {
+        write_attribute("count", spilled_string_cells_);
+        write_attribute("uniqueCount", spilled_strings_->size());
+
+        spilled_strings_->for_each([this](const std::string &text) {
+            write_start_element(xmlns, "si");
+            write_rich_text(xmlns, rich_text(text));
+            write_end_element(xmlns, "si");
+        });
+
+        write_end_element(xmlns, "sst");
+
+        return;
+    }
+
     // todo: is there a more elegant way to get this number?
     std::size_t string_count = 0;
 
@@ -922,24 +1151,12 @@ void xlsx_producer::write_shared_string_table(const relationship & /*rel*/)
 #pragma clang diagnostic ignored "-Wrange-loop-analysis"
     for (const auto ws : source_)
     {
-        auto dimension = ws.calculate_dimension();
-        auto current_cell = dimension.top_left();
-
-        while (current_cell.row() <= dimension.bottom_right().row())
+        for (const auto &cell : ws.d_->cell_map_)
         {
-            while (current_cell.column() <= dimension.bottom_right().column())
+            if (cell.type_ == cell::type::shared_string)
             {
-                if (ws.has_cell(current_cell)
-                    && ws.cell(current_cell).data_type() == cell::type::shared_string)
-                {
-                    ++string_count;
-                }
-
-                current_cell.column_index(current_cell.column_index() + 1);
+                ++string_count;
             }
-
-            current_cell.row(current_cell.row() + 1);
-            current_cell.column_index(dimension.top_left().column_index());
         }
     }
 #pragma clang diagnostic pop
@@ -950,7 +1167,7 @@ void xlsx_producer::write_shared_string_table(const relationship & /*rel*/)
     for (const auto &string : source_.shared_strings_by_id())
     {
         write_start_element(xmlns, "si");
-        write_rich_text(xmlns, string.second);
+        write_rich_text(xmlns, string);
         write_end_element(xmlns, "si");
     }
 
@@ -2207,10 +2424,9 @@ void xlsx_producer::write_worksheet(const relationship &rel)
                 return true;
             }
 
-            auto highest = ws.highest_row();
-            for (auto row = ws.lowest_row(); row <= highest; ++row)
+            for (const auto &props : ws.d_->row_properties_)
             {
-                if (ws.has_row_properties(row) && ws.row_properties(row).dy_descent.is_set())
+                if (props.second.dy_descent.is_set())
                 {
                     return true;
                 }
@@ -2295,8 +2511,12 @@ void xlsx_producer::write_worksheet(const relationship &rel)
         const auto wb_view = source_.view();
         const auto view = ws.view();
 
-        if ((wb_view.active_tab.is_set() && (ws.id() - 1) == wb_view.active_tab.get())
-            || (!wb_view.active_tab.is_set() && ws.id() == 1))
+        // active_tab is a position, which no longer matches the id once
+        // a load has left sheets out
+        const auto position = static_cast<std::size_t>(std::distance(source_.begin(),
+            std::find(source_.begin(), source_.end(), ws)));
+
+        if (position == (wb_view.active_tab.is_set() ? wb_view.active_tab.get() : 0))
         {
             write_attribute("tabSelected", write_bool(true));
         }
@@ -2454,58 +2674,123 @@ void xlsx_producer::write_worksheet(const relationship &rel)
     std::vector<std::pair<std::string, hyperlink>> hyperlinks;
     std::vector<cell_reference> cells_with_comments;
 
+    // Shared formulas are written back in their compact form, with the text on
+    // the first remaining cell of each group and the ref attribute narrowed to the
+    // cells still in it. Readers anchor ref at that cell, so cells left of it,
+    // which are only there if the group's first cells were removed, get formulas
+    // of their own instead. Groups are renumbered from zero in the order they're met.
+    const auto &shared_formulas = ws.d_->shared_formulas_;
+    shared_formula_ranges_.assign(shared_formulas.size(), range_reference());
+    shared_formula_written_.assign(shared_formulas.size(), false);
+    shared_formula_indices_.assign(shared_formulas.size(), 0);
+    next_shared_formula_index_ = 0;
+
+    if (!shared_formulas.empty())
+    {
+        for (const auto &cell : ws.d_->cell_map_)
+        {
+            if (cell.shared_formula_ == 0) continue;
+
+            const auto group = cell.shared_formula_ - 1;
+            const auto position = cell_reference(cell.column_, cell.row_);
+            auto &range = shared_formula_ranges_[group];
+
+            if (!shared_formula_written_[group])
+            {
+                range = range_reference(position, position);
+                shared_formula_written_[group] = true;
+                continue;
+            }
+
+            if (cell.column_ < range.top_left().column())
+            {
+                continue;
+            }
+
+            range = range_reference(
+                cell_reference(std::min(range.top_left().column(), cell.column_),
+                    std::min(range.top_left().row(), cell.row_)),
+                cell_reference(std::max(range.bottom_right().column(), cell.column_),
+                    std::max(range.bottom_right().row(), cell.row_)));
+        }
+
+        std::fill(shared_formula_written_.begin(), shared_formula_written_.end(), false);
+    }
+
     write_start_element(xmlns, "sheetData");
-    auto first_row = ws.lowest_row_or_props();
-    auto last_row = ws.highest_row_or_props();
+
+    // Only rows with cells or properties are visited, in order, so that the cost
+    // of writing a sheet depends on its contents rather than the area it spans.
+    const auto &cell_rows = ws.d_->cell_map_.rows();
+    auto property_rows = std::vector<row_t>();
+    property_rows.reserve(ws.d_->row_properties_.size());
+
+    for (const auto &props : ws.d_->row_properties_)
+    {
+        property_rows.push_back(props.first);
+    }
+
+    std::sort(property_rows.begin(), property_rows.end());
+
+    auto cell_row_iter = cell_rows.begin();
+    auto property_row_iter = property_rows.begin();
+    auto current_block = constants::max_row();
     auto first_block_column = constants::max_column();
     auto last_block_column = constants::min_column();
 
-    for (auto row = first_row; row <= last_row; ++row)
+    while (cell_row_iter != cell_rows.end() || property_row_iter != property_rows.end())
     {
-        bool any_non_null = false;
-        auto first_check_row = row;
-        auto last_check_row = row;
-        auto first_row_in_block = row == first_row || row % 16 == 1;
+        auto row = row_t(0);
+        const detail::cell_store::row_cells *row_cells = nullptr;
+
+        if (cell_row_iter != cell_rows.end()
+            && (property_row_iter == property_rows.end() || cell_row_iter->first <= *property_row_iter))
+        {
+            row = cell_row_iter->first;
+            row_cells = &cell_row_iter->second;
+            ++cell_row_iter;
+        }
+        else
+        {
+            row = *property_row_iter;
+        }
+
+        if (property_row_iter != property_rows.end() && *property_row_iter == row)
+        {
+            ++property_row_iter;
+        }
+
+        auto any_non_null = row_cells != nullptr
+            && std::any_of(row_cells->begin(), row_cells->end(),
+                [](const detail::cell_impl *cell) { return !cell->is_garbage_collectible(); });
+
+        if (!any_non_null && !ws.has_row_properties(row)) continue;
 
         // See note for CT_Row, span attribute about block optimization
-        if (first_row_in_block)
+        auto block = (row - 1) / 16;
+
+        if (block != current_block)
         {
+            current_block = block;
+
             // reset block column range
             first_block_column = constants::max_column();
             last_block_column = constants::min_column();
 
-            first_check_row = row;
-            // round up to the next multiple of 16
-            last_check_row = ((row / 16) + 1) * 16;
-        }
-
-        for (auto check_row = first_check_row; check_row <= last_check_row; ++check_row)
-        {
-            for (auto column = dimension.top_left().column(); column <= dimension.bottom_right().column(); ++column)
+            for (auto block_row = cell_rows.lower_bound(row);
+                 block_row != cell_rows.end() && (block_row->first - 1) / 16 == block;
+                 ++block_row)
             {
-                auto ref = cell_reference(column, check_row);
-                auto cell = ws.d_->cell_map_.find(ref);
-                if (cell == ws.d_->cell_map_.end())
-                {
-                    continue;
-                }
-                if (cell->second.is_garbage_collectible())
+                for (auto cell : block_row->second)
                 {
-                    continue;
-                }
-
-                first_block_column = std::min(first_block_column, cell->second.column_);
-                last_block_column = std::max(last_block_column, cell->second.column_);
+                    if (cell->is_garbage_collectible()) continue;
 
-                if (row == check_row)
-                {
-                    any_non_null = true;
+                    first_block_column = std::min(first_block_column, cell->column_);
+                    last_block_column = std::max(last_block_column, cell->column_);
                 }
             }
         }
 
-        if (!any_non_null && !ws.has_row_properties(row)) continue;
-
         write_start_element(xmlns, "row");
         write_attribute("r", row);
 
@@ -2550,11 +2835,9 @@ void xlsx_producer::write_worksheet(const relationship &rel)
 
         if (any_non_null)
         {
-            for (auto column = dimension.top_left().column(); column <= dimension.bottom_right().column(); ++column)
+            for (auto cell_impl : *row_cells)
             {
-                if (!ws.has_cell(cell_reference(column, row))) continue;
-
-                auto cell = ws.cell(cell_reference(column, row));
+                auto cell = xlnt::cell(cell_impl);
 
                 if (cell.garbage_collectible()) continue;
 
@@ -2570,106 +2853,7 @@ void xlsx_producer::write_worksheet(const relationship &rel)
                     hyperlinks.push_back(std::make_pair(cell.reference().to_string(), cell.hyperlink()));
                 }
 
-                write_start_element(xmlns, "c");
-
-                // begin cell attributes
-
-                write_attribute("r", cell.reference().to_string());
-
-                if (cell.phonetics_visible())
-                {
-                    write_attribute("ph", write_bool(true));
-                }
-
-                if (cell.has_format())
-                {
-                    write_attribute("s", cell.format().d_->id);
-                }
-
-                switch (cell.data_type())
-                {
-                case cell::type::empty:
-                    break;
-
-                case cell::type::boolean:
-                    write_attribute("t", "b");
-                    break;
-
-                case cell::type::date:
-                    write_attribute("t", "d");
-                    break;
-
-                case cell::type::error:
-                    write_attribute("t", "e");
-                    break;
-
-                case cell::type::inline_string:
-                    write_attribute("t", "inlineStr");
-                    break;
-
-                case cell::type::number: // default, don't write it
-                    //write_attribute("t", "n");
-                    break;
-
-                case cell::type::shared_string:
-                    write_attribute("t", "s");
-                    break;
-
-                case cell::type::formula_string:
-                    write_attribute("t", "str");
-                    break;
-                }
-
-                //write_attribute("cm", "");
-                //write_attribute("vm", "");
-                //write_attribute("ph", "");
-
-                // begin child elements
-
-                if (cell.has_formula())
-                {
-                    write_element(xmlns, "f", cell.formula());
-                }
-
-                switch (cell.data_type())
-                {
-                case cell::type::empty:
-                    break;
-
-                case cell::type::boolean:
-                    write_element(xmlns, "v", write_bool(cell.value<bool>()));
-                    break;
-
-                case cell::type::date:
-                    write_element(xmlns, "v", cell.value<std::string>());
-                    break;
-
-                case cell::type::error:
-                    write_element(xmlns, "v", cell.value<std::string>());
-                    break;
-
-                case cell::type::inline_string:
-                    write_start_element(xmlns, "is");
-                    write_rich_text(xmlns, cell.value<xlnt::rich_text>());
-                    write_end_element(xmlns, "is");
-                    break;
-
-                case cell::type::number:
-                    write_start_element(xmlns, "v");
-                    write_characters(converter_.serialise(cell.value<double>()));
-                    write_end_element(xmlns, "v");
-                    break;
-
-                case cell::type::shared_string:
-                    write_element(xmlns, "v", static_cast<std::size_t>(cell.d_->value_numeric_));
-                    break;
-
-                case cell::type::formula_string:
-                    write_element(xmlns, "v", cell.value<std::string>());
-                    break;
-                }
-
-                write_end_element(xmlns, "c");
+                write_cell(cell);
             }
         }
 
@@ -3072,6 +3256,138 @@ void xlsx_producer::write_worksheet(const relationship &rel)
     }
 }
 
+void xlsx_producer::write_cell(const cell &cell)
+{
+    static const auto &xmlns = constants::ns("spreadsheetml");
+
+    write_start_element(xmlns, "c");
+
+    // begin cell attributes
+
+    write_attribute("r", cell.reference().to_string());
+
+    if (cell.phonetics_visible())
+    {
+        write_attribute("ph", write_bool(true));
+    }
+
+    if (cell.has_format())
+    {
+        write_attribute("s", cell.format().d_->id);
+    }
+
+    switch (cell.data_type())
+    {
+    case cell::type::empty:
+        break;
+
+    case cell::type::boolean:
+        write_attribute("t", "b");
+        break;
+
+    case cell::type::date:
+        write_attribute("t", "d");
+        break;
+
+    case cell::type::error:
+        write_attribute("t", "e");
+        break;
+
+    case cell::type::inline_string:
+        write_attribute("t", "inlineStr");
+        break;
+
+    case cell::type::number: // default, don't write it
+        //write_attribute("t", "n");
+        break;
+
+    case cell::type::shared_string:
+        write_attribute("t", "s");
+        break;
+
+    case cell::type::formula_string:
+        write_attribute("t", "str");
+        break;
+    }
+
+    //write_attribute("cm", "");
+    //write_attribute("vm", "");
+    //write_attribute("ph", "");
+
+    // begin child elements
+
+    const auto shared = cell.d_->shared_formula_ != 0
+        && cell.d_->column_ >= shared_formula_ranges_[cell.d_->shared_formula_ - 1].top_left().column();
+
+    if (shared)
+    {
+        const auto group = cell.d_->shared_formula_ - 1;
+
+        write_start_element(xmlns, "f");
+        write_attribute("t", "shared");
+
+        if (!shared_formula_written_[group])
+        {
+            shared_formula_written_[group] = true;
+            shared_formula_indices_[group] = next_shared_formula_index_++;
+
+            write_attribute("ref", shared_formula_ranges_[group].to_string());
+            write_attribute("si", shared_formula_indices_[group]);
+            write_characters(cell.formula());
+        }
+        else
+        {
+            write_attribute("si", shared_formula_indices_[group]);
+        }
+
+        write_end_element(xmlns, "f");
+    }
+    else if (cell.has_formula())
+    {
+        write_element(xmlns, "f", cell.formula());
+    }
+
+    switch (cell.data_type())
+    {
+    case cell::type::empty:
+        break;
+
+    case cell::type::boolean:
+        write_element(xmlns, "v", write_bool(cell.value<bool>()));
+        break;
+
+    case cell::type::date:
+        write_element(xmlns, "v", cell.value<std::string>());
+        break;
+
+    case cell::type::error:
+        write_element(xmlns, "v", cell.value<std::string>());
+        break;
+
+    case cell::type::inline_string:
+        write_start_element(xmlns, "is");
+        write_rich_text(xmlns, cell.value<xlnt::rich_text>());
+        write_end_element(xmlns, "is");
+        break;
+
+    case cell::type::number:
+        write_start_element(xmlns, "v");
+        write_number(cell.d_->value_numeric_);
+        write_end_element(xmlns, "v");
+        break;
+
+    case cell::type::shared_string:
+        write_element(xmlns, "v", static_cast<std::size_t>(cell.d_->value_numeric_));
+        break;
+
+    case cell::type::formula_string:
+        write_element(xmlns, "v", cell.value<std::string>());
+        break;
+    }
+
+    write_end_element(xmlns, "c");
+}
+
 // Sheet Relationship Target Parts
 
 void xlsx_producer::write_comments(const relationship & /*rel*/, worksheet ws, const std::vector<cell_reference> &cells)
@@ -3416,6 +3732,12 @@ void xlsx_producer::write_end_element(const std::string &ns, const std::string &
     current_part_serializer_->end_element(ns, name);
 }
 
+void xlsx_producer::write_number(double value)
+{
+    converter_.serialise(value, number_text_);
+    current_part_serializer_->characters(number_text_);
+}
+
 void xlsx_producer::write_namespace(const std::string &ns, const std::string &prefix)
 {
     current_part_serializer_->namespace_decl(ns, prefix);
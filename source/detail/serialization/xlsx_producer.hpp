@@ -26,11 +26,14 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <detail/constants.hpp>
 #include <detail/external/include_libstudxml.hpp>
+#include <xlnt/cell/index_types.hpp>
 #include <xlnt/utils/numeric.hpp>
+#include <xlnt/worksheet/range_reference.hpp>
 
 namespace xml {
 class serializer;
@@ -44,6 +47,7 @@ class cell_reference;
 class color;
 class fill;
 class font;
+class format;
 class path;
 class relationship;
 class rich_text;
@@ -56,6 +60,8 @@ namespace detail {
 
 class ozstream;
 struct cell_impl;
+struct format_impl;
+class spilled_string_table;
 struct worksheet_impl;
 
 /// <summary>
@@ -75,11 +81,68 @@ public:
 private:
     friend class xlnt::streaming_workbook_writer;
 
+    // Streaming, see streaming_workbook_writer
+
+    /// <summary>
+    /// Begins writing a workbook to destination one worksheet part at a time.
+    /// The remaining parts are written by close().
+    /// </summary>
     void open(std::ostream &destination);
 
+    /// <summary>
+    /// Finishes the worksheet being written and writes every other part of the
+    /// workbook, skipping the worksheet parts that were already written.
+    /// </summary>
+    void close();
+
+    /// <summary>
+    /// Finishes the worksheet being written, if any, and starts the part of ws.
+    /// </summary>
+    void begin_worksheet(worksheet ws);
+
+    /// <summary>
+    /// Closes the row and the part of the worksheet being written, if any.
+    /// </summary>
+    void end_worksheet();
+
+    /// <summary>
+    /// Writes the previous cell and returns a blank cell at ref to be written next.
+    /// ref must be after the previous cell in row-major order.
+    /// </summary>
     cell add_cell(const cell_reference &ref);
 
-    worksheet add_worksheet(const std::string &title);
+    /// <summary>
+    /// Moves to the start of the row after the last one written to.
+    /// </summary>
+    void add_row();
+
+    /// <summary>
+    /// Returns a blank cell to the right of the last one in the current row,
+    /// as add_cell does.
+    /// </summary>
+    cell append_cell();
+
+    /// <summary>
+    /// Applies row_format to the cells appended to the current row from now on.
+    /// </summary>
+    void append_format(const format &row_format);
+
+    /// <summary>
+    /// Appends a cell holding text as an inline string.
+    /// </summary>
+    void append_string(const std::string &text);
+
+    /// <summary>
+    /// Makes strings written from now on go to spilled_strings_, which is
+    /// written as the shared string table by close().
+    /// </summary>
+    void spill_shared_strings();
+
+    /// <summary>
+    /// Writes the cell at the end of the current row, if it has anything
+    /// worth writing, and resets it for reuse.
+    /// </summary>
+    void write_pending_cell();
 
 	/// <summary>
 	/// Write all files needed to create a valid XLSX file which represents all
@@ -121,6 +184,12 @@ private:
 	void write_dialogsheet(const relationship &rel);
 	void write_worksheet(const relationship &rel);
 
+    /// <summary>
+    /// Writes the <c> element of cell, using the shared formula state of the
+    /// worksheet being written.
+    /// </summary>
+    void write_cell(const cell &cell);
+
 	// Sheet Relationship Target Parts
 
 	void write_comments(const relationship &rel, worksheet ws, const std::vector<cell_reference> &cells);
@@ -181,6 +250,11 @@ private:
         current_part_serializer_->attribute(name, value);
     }
 
+    /// <summary>
+    /// Writes value as the character content of the current element.
+    /// </summary>
+    void write_number(double value);
+
     template<typename T>
     void write_characters(T characters, bool preserve_whitespace = false)
     {
@@ -204,12 +278,57 @@ private:
 
     bool streaming_ = false;
 
+    /// <summary>
+    /// The cell returned by add_cell or append_cell, which is written once the
+    /// next one is asked for, and the worksheet it belongs to.
+    /// </summary>
     std::unique_ptr<detail::cell_impl> streaming_cell_;
-
-    detail::cell_impl *current_cell_;
-
-    detail::worksheet_impl *current_worksheet_;
+    bool streaming_cell_pending_ = false;
+
+    /// <summary>
+    /// The format given to appended cells, set by append_format until the next row.
+    /// </summary>
+    detail::format_impl *streaming_format_ = nullptr;
+
+    /// <summary>
+    /// The shared strings of streamed cells once spill_shared_strings has been
+    /// called, along with the number of cells that use them. While set,
+    /// streaming_cell_spilled_ is true if value_numeric_ of the cell being
+    /// written is already an index into this table rather than the workbook's.
+    /// </summary>
+    std::unique_ptr<spilled_string_table> spilled_strings_;
+    std::size_t spilled_string_cells_ = 0;
+    bool streaming_cell_spilled_ = false;
+
+    detail::worksheet_impl *current_worksheet_ = nullptr;
+
+    /// <summary>
+    /// The number of worksheets written so far by the streaming methods.
+    /// </summary>
+    std::size_t streamed_worksheets_ = 0;
+
+    /// <summary>
+    /// The position of the last cell added while streaming, where column 0
+    /// means no cell in that row yet, and whether its <row> is open.
+    /// </summary>
+    row_t streaming_row_ = 0;
+    column_t::index_t streaming_column_ = 0;
+    bool streaming_row_open_ = false;
+
+    /// <summary>
+    /// Per shared formula of the worksheet being written, the range of cells
+    /// still in it, whether it has been written and the si it was given.
+    /// </summary>
+    std::vector<range_reference> shared_formula_ranges_;
+    std::vector<bool> shared_formula_written_;
+    std::vector<std::size_t> shared_formula_indices_;
+    std::size_t next_shared_formula_index_ = 0;
     detail::number_serialiser converter_;
+
+    /// <summary>
+    /// Scratch space for write_number which keeps its capacity between cells.
+    /// </summary>
+    std::string number_text_;
 };
 
 } // namespace detail
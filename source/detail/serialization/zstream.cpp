@@ -306,6 +306,40 @@ public:
     virtual int overflow(int c = EOF);
 };
 
+/// <summary>
+/// Owns a copy of a compressed archive member. This is a separate base of
+/// zip_streambuf_detached so that it's constructed before the decompressor
+/// that reads from it.
+/// </summary>
+class zip_detached_source
+{
+protected:
+    zip_detached_source(std::vector<std::uint8_t> &&bytes)
+        : bytes_(std::move(bytes)),
+          buffer_(bytes_),
+          stream_(&buffer_)
+    {
+    }
+
+    std::vector<std::uint8_t> bytes_;
+    vector_istreambuf buffer_;
+    std::istream stream_;
+};
+
+/// <summary>
+/// Decompresses an archive member from its own copy of the compressed data
+/// instead of the archive's stream.
+/// </summary>
+class zip_streambuf_detached : private zip_detached_source, public zip_streambuf_decompress
+{
+public:
+    zip_streambuf_detached(std::vector<std::uint8_t> &&bytes, const zheader &central_header)
+        : zip_detached_source(std::move(bytes)),
+          zip_streambuf_decompress(stream_, central_header)
+    {
+    }
+};
+
 int zip_streambuf_decompress::overflow(int)
 {
     throw xlnt::exception("writing to read-only buffer");
@@ -360,25 +394,33 @@ public:
 
     virtual ~zip_streambuf_compress()
     {
-        if (valid)
+        // a stream that throws on errors mustn't do so from here, and is
+        // left with badbit set anyway
+        try
         {
-            process(true);
-            deflateEnd(&strm);
-            if (header)
-            {
-                auto final_position = ostream.tellp();
-                header->uncompressed_size = uncompressed_size;
-                header->crc = crc;
-                ostream.seekp(header->header_offset);
-                write_header(*header, ostream, false);
-                ostream.seekp(final_position);
-            }
-            else
+            if (valid)
             {
-                write_int(ostream, crc);
-                write_int(ostream, uncompressed_size);
+                process(true);
+                deflateEnd(&strm);
+                if (header)
+                {
+                    auto final_position = ostream.tellp();
+                    header->uncompressed_size = uncompressed_size;
+                    header->crc = crc;
+                    ostream.seekp(header->header_offset);
+                    write_header(*header, ostream, false);
+                    ostream.seekp(final_position);
+                }
+                else
+                {
+                    write_int(ostream, crc);
+                    write_int(ostream, uncompressed_size);
+                }
             }
         }
+        catch (...)
+        {
+        }
         if (!header) delete &ostream;
     }
 
@@ -455,25 +497,32 @@ ozstream::ozstream(std::ostream &stream)
 
 ozstream::~ozstream()
 {
-    // Write all file headers
-    auto final_position = destination_stream_.tellp();
-
-    for (const auto &header : file_headers_)
+    // as for zip_streambuf_compress, errors are left in the stream's state
+    try
     {
-        write_header(header, destination_stream_, true);
-    }
+        // Write all file headers
+        auto final_position = destination_stream_.tellp();
 
-    auto central_end = destination_stream_.tellp();
+        for (const auto &header : file_headers_)
+        {
+            write_header(header, destination_stream_, true);
+        }
 
-    // Write end of central
-    write_int(destination_stream_, static_cast<std::uint32_t>(0x06054b50)); // end of central
-    write_int(destination_stream_, static_cast<std::uint16_t>(0)); // this disk number
-    write_int(destination_stream_, static_cast<std::uint16_t>(0)); // this disk number
-    write_int(destination_stream_, static_cast<std::uint16_t>(file_headers_.size())); // one entry in center in this disk
-    write_int(destination_stream_, static_cast<std::uint16_t>(file_headers_.size())); // one entry in center
-    write_int(destination_stream_, static_cast<std::uint32_t>(central_end - final_position)); // size of header
-    write_int(destination_stream_, static_cast<std::uint32_t>(final_position)); // offset to header
-    write_int(destination_stream_, static_cast<std::uint16_t>(0)); // zip comment
+        auto central_end = destination_stream_.tellp();
+
+        // Write end of central
+        write_int(destination_stream_, static_cast<std::uint32_t>(0x06054b50)); // end of central
+        write_int(destination_stream_, static_cast<std::uint16_t>(0)); // this disk number
+        write_int(destination_stream_, static_cast<std::uint16_t>(0)); // this disk number
+        write_int(destination_stream_, static_cast<std::uint16_t>(file_headers_.size())); // one entry in center in this disk
+        write_int(destination_stream_, static_cast<std::uint16_t>(file_headers_.size())); // one entry in center
+        write_int(destination_stream_, static_cast<std::uint32_t>(central_end - final_position)); // size of header
+        write_int(destination_stream_, static_cast<std::uint32_t>(final_position)); // offset to header
+        write_int(destination_stream_, static_cast<std::uint16_t>(0)); // zip comment
+    }
+    catch (...)
+    {
+    }
 }
 
 std::unique_ptr<std::streambuf> ozstream::open(const path &filename)
@@ -604,6 +653,36 @@ std::unique_ptr<std::streambuf> izstream::open(const path &filename) const
     return std::unique_ptr<zip_streambuf_decompress>(buffer);
 }
 
+std::unique_ptr<std::streambuf> izstream::open_detached(const path &filename) const
+{
+    if (!has_file(filename))
+    {
+        throw xlnt::exception("file not found");
+    }
+
+    const auto &header = file_headers_.at(filename.string());
+    source_stream_.seekg(header.header_offset);
+
+    // the local header is 30 bytes followed by the file name and an extra field
+    // whose lengths can differ from those in the central directory
+    const auto local_header_size = std::size_t(30);
+    std::vector<std::uint8_t> bytes(local_header_size);
+    source_stream_.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(local_header_size));
+
+    const auto filename_length = static_cast<std::size_t>(bytes[26] | (bytes[27] << 8));
+    const auto extra_length = static_cast<std::size_t>(bytes[28] | (bytes[29] << 8));
+    const auto remaining = filename_length + extra_length + header.compressed_size;
+    bytes.resize(local_header_size + remaining);
+    source_stream_.read(reinterpret_cast<char *>(bytes.data() + local_header_size), static_cast<std::streamsize>(remaining));
+
+    if (static_cast<std::size_t>(source_stream_.gcount()) != remaining)
+    {
+        throw xlnt::exception("couldn't read ZIP, possibly corrupted");
+    }
+
+    return std::unique_ptr<std::streambuf>(new zip_streambuf_detached(std::move(bytes), header));
+}
+
 std::string izstream::read(const path &filename) const
 {
     auto buffer = open(filename);
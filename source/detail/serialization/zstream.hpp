@@ -117,6 +117,13 @@ public:
     /// </summary>
     std::unique_ptr<std::streambuf> open(const path &file) const;
 
+    /// <summary>
+    /// Like open, but the compressed data is copied up front so that the returned
+    /// buffer doesn't use the archive's stream. It can then be read on another
+    /// thread while this archive is in use.
+    /// </summary>
+    std::unique_ptr<std::streambuf> open_detached(const path &file) const;
+
     /// <summary>
     ///
     /// </summary>
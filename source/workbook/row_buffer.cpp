@@ -0,0 +1,63 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <xlnt/workbook/row_buffer.hpp>
+
+namespace xlnt {
+
+void row_buffer::clear()
+{
+    rows.clear();
+    columns.clear();
+    types.clear();
+    numbers.clear();
+    shared_strings.clear();
+    formats.clear();
+    text_offsets.clear();
+    text_sizes.clear();
+    characters.clear();
+    last_row = 0;
+}
+
+std::size_t row_buffer::size() const
+{
+    return columns.size();
+}
+
+bool row_buffer::empty() const
+{
+    return columns.empty();
+}
+
+const char *row_buffer::text_data(std::size_t index) const
+{
+    return characters.data() + text_offsets.at(index);
+}
+
+std::string row_buffer::text(std::size_t index) const
+{
+    return characters.substr(text_offsets.at(index), text_sizes.at(index));
+}
+
+} // namespace xlnt
@@ -26,11 +26,13 @@
 #include <xlnt/cell/cell.hpp>
 #include <xlnt/packaging/manifest.hpp>
 #include <xlnt/utils/optional.hpp>
+#include <xlnt/workbook/row_buffer.hpp>
 #include <xlnt/workbook/streaming_workbook_reader.hpp>
 #include <xlnt/workbook/workbook.hpp>
 #include <xlnt/worksheet/worksheet.hpp>
 #include <detail/implementations/workbook_impl.hpp>
 #include <detail/serialization/open_stream.hpp>
+#include <detail/serialization/sheet_data_scanner.hpp>
 #include <detail/serialization/vector_streambuf.hpp>
 #include <detail/serialization/xlsx_consumer.hpp>
 
@@ -64,6 +66,25 @@ cell streaming_workbook_reader::read_cell()
     return consumer_->read_cell();
 }
 
+bool streaming_workbook_reader::read_row(row_buffer &row)
+{
+    row.clear();
+    return consumer_->read_row(row);
+}
+
+std::size_t streaming_workbook_reader::read_rows(std::size_t count, row_buffer &batch)
+{
+    batch.clear();
+    auto read = std::size_t(0);
+
+    while (read < count && consumer_->read_row(batch))
+    {
+        ++read;
+    }
+
+    return read;
+}
+
 bool streaming_workbook_reader::has_worksheet(const std::string &name)
 {
     auto titles = sheet_titles();
@@ -89,9 +110,12 @@ void streaming_workbook_reader::begin_worksheet(const std::string &title)
     const auto part_path = manifest.canonicalize(rel_chain);
     auto part_stream_buffer = consumer_->archive_->open(part_path);
     part_stream_buffer_.swap(part_stream_buffer);
-    part_stream_.reset(new std::istream(part_stream_buffer_.get()));
+    // sheetData is read by a sheet_data_scanner as cells are asked for, see xlsx_consumer::has_cell
+    sheet_data_.reset(new detail::sheet_data_splitter(*part_stream_buffer_, part_path.string()));
+    part_stream_.reset(new std::istream(sheet_data_.get()));
     parser_.reset(new xml::parser(*part_stream_, part_path.string()));
     consumer_->parser_ = parser_.get();
+    consumer_->sheet_data_ = sheet_data_.get();
 
     consumer_->current_worksheet_ = nullptr;
 
@@ -148,7 +172,7 @@ void streaming_workbook_reader::open(const xlnt::path &filename)
 
 void streaming_workbook_reader::open(std::istream &stream)
 {
-    workbook_.reset(new workbook());
+    workbook_.reset(new xlnt::workbook());
     consumer_.reset(new detail::xlsx_consumer(*workbook_));
     consumer_->open(stream);
 
@@ -169,4 +193,9 @@ std::vector<std::string> streaming_workbook_reader::sheet_titles()
     return workbook_->sheet_titles();
 }
 
+const xlnt::workbook &streaming_workbook_reader::workbook() const
+{
+    return *workbook_;
+}
+
 } // namespace xlnt
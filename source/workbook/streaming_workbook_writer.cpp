@@ -25,7 +25,12 @@
 
 #include <xlnt/cell/cell.hpp>
 #include <xlnt/packaging/manifest.hpp>
+#include <xlnt/styles/format.hpp>
+#include <xlnt/utils/date.hpp>
+#include <xlnt/utils/datetime.hpp>
 #include <xlnt/utils/optional.hpp>
+#include <xlnt/utils/time.hpp>
+#include <xlnt/utils/timedelta.hpp>
 #include <xlnt/workbook/streaming_workbook_writer.hpp>
 #include <xlnt/workbook/workbook.hpp>
 #include <xlnt/worksheet/worksheet.hpp>
@@ -43,16 +48,27 @@ streaming_workbook_writer::streaming_workbook_writer()
 
 streaming_workbook_writer::~streaming_workbook_writer()
 {
-    close();
+    // errors can't be reported from here, see close()
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
 }
 
 void streaming_workbook_writer::close()
 {
-    if (producer_)
-    {
-        producer_.reset(nullptr);
-        stream_buffer_.reset(nullptr);
-    }
+    if (!producer_) return;
+
+    // the writer is closed afterwards even if finishing the package fails,
+    // with the producer released before the stream it writes to
+    auto stream_buffer = std::move(stream_buffer_);
+    auto stream = std::move(stream_);
+    auto producer = std::move(producer_);
+
+    producer->close();
 }
 
 cell streaming_workbook_writer::add_cell(const cell_reference &ref)
@@ -62,7 +78,107 @@ cell streaming_workbook_writer::add_cell(const cell_reference &ref)
 
 worksheet streaming_workbook_writer::add_worksheet(const std::string &title)
 {
-    return producer_->add_worksheet(title);
+    // the worksheet being written is finished before the workbook changes
+    producer_->end_worksheet();
+
+    auto ws = producer_->streamed_worksheets_ == 0
+        ? workbook_->sheet_by_index(0)
+        : workbook_->create_sheet();
+    ws.title(title);
+    producer_->begin_worksheet(ws);
+
+    return ws;
+}
+
+void streaming_workbook_writer::spill_shared_strings()
+{
+    producer_->spill_shared_strings();
+    workbook_->register_workbook_part(relationship_type::shared_string_table);
+}
+
+xlnt::workbook &streaming_workbook_writer::workbook()
+{
+    return *workbook_;
+}
+
+void streaming_workbook_writer::begin_row()
+{
+    producer_->add_row();
+}
+
+void streaming_workbook_writer::append_value(std::nullptr_t)
+{
+    producer_->append_cell();
+}
+
+void streaming_workbook_writer::append_value(bool value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(int value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(unsigned int value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(long long int value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(unsigned long long int value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(float value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(double value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(const date &value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(const time &value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(const datetime &value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(const timedelta &value)
+{
+    producer_->append_cell().value(value);
+}
+
+void streaming_workbook_writer::append_value(const std::string &value)
+{
+    producer_->append_string(value);
+}
+
+void streaming_workbook_writer::append_value(const char *value)
+{
+    producer_->append_string(value);
+}
+
+void streaming_workbook_writer::append_value(const format &value)
+{
+    producer_->append_format(value);
 }
 
 void streaming_workbook_writer::open(std::vector<std::uint8_t> &data)
@@ -97,12 +213,9 @@ void streaming_workbook_writer::open(const xlnt::path &filename)
 
 void streaming_workbook_writer::open(std::ostream &stream)
 {
-    workbook_.reset(new workbook());
+    workbook_.reset(new xlnt::workbook());
     producer_.reset(new detail::xlsx_producer(*workbook_));
     producer_->open(stream);
-    producer_->current_worksheet_ = new detail::worksheet_impl(workbook_.get(), 1, "Sheet1");
-    producer_->current_cell_ = new detail::cell_impl();
-    producer_->current_cell_->parent_ = producer_->current_worksheet_;
 }
 
 } // namespace xlnt
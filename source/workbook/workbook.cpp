@@ -80,6 +80,18 @@ std::vector<T> keys(const std::vector<std::pair<T, xlnt::variant>> &container)
     return result;
 }
 
+/// <summary>
+/// Reads ws if a lazy load left it unread, before a handle to it is given out.
+/// </summary>
+void read_if_deferred(const xlnt::workbook &wb, xlnt::detail::worksheet_impl &ws)
+{
+    if (ws.deferred_)
+    {
+        // reading the worksheet doesn't change the workbook as seen from outside
+        xlnt::detail::xlsx_consumer::read_deferred_worksheet(const_cast<xlnt::workbook &>(wb), ws);
+    }
+}
+
 template <typename T>
 bool contains(const std::vector<std::pair<T, xlnt::variant>> &container, const T key)
 {
@@ -486,6 +498,9 @@ workbook workbook::empty()
         .number_format(xlnt::number_format::general())
         .style("Normal");
 
+    // drop the intermediate formats created by the chain above
+    stylesheet.garbage_collect();
+
     xlnt::calculation_properties calc_props;
     calc_props.calc_id = 150000;
     calc_props.concurrent_calc = false;
@@ -512,6 +527,12 @@ workbook::workbook(const xlnt::path &file, const std::string &password)
     load(file, password);
 }
 
+workbook::workbook(const xlnt::path &file, const load_options &options)
+{
+    *this = empty();
+    load(file, options);
+}
+
 workbook::workbook(std::istream &data)
 {
     *this = empty();
@@ -524,6 +545,12 @@ workbook::workbook(std::istream &data, const std::string &password)
     load(data, password);
 }
 
+workbook::workbook(std::istream &data, const load_options &options)
+{
+    *this = empty();
+    load(data, options);
+}
+
 workbook::workbook(detail::workbook_impl *impl)
     : d_(impl)
 {
@@ -642,6 +669,7 @@ const worksheet workbook::sheet_by_title(const std::string &title) const
     {
         if (impl.title_ == title)
         {
+            read_if_deferred(*this, impl);
             return worksheet(&impl);
         }
     }
@@ -655,6 +683,7 @@ worksheet workbook::sheet_by_title(const std::string &title)
     {
         if (impl.title_ == title)
         {
+            read_if_deferred(*this, impl);
             return worksheet(&impl);
         }
     }
@@ -676,6 +705,7 @@ worksheet workbook::sheet_by_index(std::size_t index)
         ++iter;
     }
 
+    read_if_deferred(*this, *iter);
     return worksheet(&*iter);
 }
 
@@ -687,6 +717,7 @@ const worksheet workbook::sheet_by_index(std::size_t index) const
     {
     }
 
+    read_if_deferred(*this, *iter);
     return worksheet(&*iter);
 }
 
@@ -696,6 +727,7 @@ worksheet workbook::sheet_by_id(std::size_t id)
     {
         if (impl.id_ == id)
         {
+            read_if_deferred(*this, impl);
             return worksheet(&impl);
         }
     }
@@ -709,6 +741,7 @@ const worksheet workbook::sheet_by_id(std::size_t id) const
     {
         if (impl.id_ == id)
         {
+            read_if_deferred(*this, impl);
             return worksheet(&impl);
         }
     }
@@ -745,9 +778,9 @@ worksheet workbook::create_sheet()
     }
     // unique sheet id
     size_t sheet_id = 1;
-    for (const auto ws : *this)
+    for (const auto &impl : d_->worksheets_)
     {
-        sheet_id = std::max(sheet_id, ws.id() + 1);
+        sheet_id = std::max(sheet_id, impl.id_ + 1);
     }
     d_->worksheets_.push_back(detail::worksheet_impl(this, sheet_id, title));
     // unique sheet file name
@@ -862,9 +895,14 @@ range workbook::named_range(const std::string &name)
 }
 
 void workbook::load(std::istream &stream)
+{
+    load(stream, load_options());
+}
+
+void workbook::load(std::istream &stream, const load_options &options)
 {
     clear();
-    detail::xlsx_consumer consumer(*this);
+    detail::xlsx_consumer consumer(*this, options);
 
     try
     {
@@ -885,6 +923,11 @@ void workbook::load(std::istream &stream)
 }
 
 void workbook::load(const std::vector<std::uint8_t> &data)
+{
+    load(data, load_options());
+}
+
+void workbook::load(const std::vector<std::uint8_t> &data, const load_options &options)
 {
     if (data.size() < 22) // the shortest ZIP file is 22 bytes
     {
@@ -893,7 +936,7 @@ void workbook::load(const std::vector<std::uint8_t> &data)
 
     xlnt::detail::vector_istreambuf data_buffer(data);
     std::istream data_stream(&data_buffer);
-    load(data_stream);
+    load(data_stream, options);
 }
 
 void workbook::load(const std::string &filename)
@@ -901,7 +944,17 @@ void workbook::load(const std::string &filename)
     return load(path(filename));
 }
 
+void workbook::load(const std::string &filename, const load_options &options)
+{
+    return load(path(filename), options);
+}
+
 void workbook::load(const path &filename)
+{
+    load(filename, load_options());
+}
+
+void workbook::load(const path &filename, const load_options &options)
 {
     std::ifstream file_stream;
     open_stream(file_stream, filename.string());
@@ -911,7 +964,7 @@ void workbook::load(const path &filename)
         throw xlnt::exception("file not found " + filename.string());
     }
 
-    load(file_stream);
+    load(file_stream, options);
 }
 
 void workbook::load(const std::string &filename, const std::string &password)
@@ -991,12 +1044,22 @@ void workbook::save(const path &filename, const std::string &password) const
 
 void workbook::save(std::ostream &stream) const
 {
+    if (d_->stylesheet_.is_set())
+    {
+        d_->stylesheet_.get().garbage_collect_if_pending();
+    }
+
     detail::xlsx_producer producer(*this);
     producer.write(stream);
 }
 
 void workbook::save(std::ostream &stream, const std::string &password) const
 {
+    if (d_->stylesheet_.is_set())
+    {
+        d_->stylesheet_.get().garbage_collect_if_pending();
+    }
+
     detail::xlsx_producer producer(*this);
     producer.write(stream, password);
 }
@@ -1017,10 +1080,15 @@ void workbook::save(const std::wstring &filename, const std::string &password) c
 }
 
 void workbook::load(const std::wstring &filename)
+{
+    load(filename, load_options());
+}
+
+void workbook::load(const std::wstring &filename, const load_options &options)
 {
     std::ifstream file_stream;
     open_stream(file_stream, filename);
-    load(file_stream);
+    load(file_stream, options);
 }
 
 void workbook::load(const std::wstring &filename, const std::string &password)
@@ -1132,9 +1200,9 @@ std::vector<std::string> workbook::sheet_titles() const
 {
     std::vector<std::string> names;
 
-    for (auto ws : *this)
+    for (const auto &impl : d_->worksheets_)
     {
-        names.push_back(ws.title());
+        names.push_back(impl.title_);
     }
 
     return names;
@@ -1180,9 +1248,9 @@ void workbook::swap(workbook &right)
 
     if (left.d_ != nullptr)
     {
-        for (auto ws : left)
+        for (auto &impl : left.d_->worksheets_)
         {
-            ws.parent(left);
+            impl.parent_ = &left;
         }
 
         if (left.d_->stylesheet_.is_set())
@@ -1193,9 +1261,9 @@ void workbook::swap(workbook &right)
 
     if (right.d_ != nullptr)
     {
-        for (auto ws : right)
+        for (auto &impl : right.d_->worksheets_)
         {
-            ws.parent(right);
+            impl.parent_ = &right;
         }
 
         if (right.d_->stylesheet_.is_set())
@@ -1224,9 +1292,9 @@ workbook::workbook(const workbook &other)
 {
     *d_.get() = *other.d_.get();
 
-    for (auto ws : *this)
+    for (auto &impl : d_->worksheets_)
     {
-        ws.parent(*this);
+        impl.parent_ = this;
     }
 
     d_->stylesheet_.get().parent = this;
@@ -1311,6 +1379,14 @@ void workbook::clear_formats()
     apply_to_cells([](cell c) { c.clear_format(); });
 }
 
+void workbook::compact_styles()
+{
+    if (d_->stylesheet_.is_set())
+    {
+        d_->stylesheet_.get().garbage_collect();
+    }
+}
+
 void workbook::apply_to_cells(std::function<void(cell)> f)
 {
     for (auto ws : *this)
@@ -1348,60 +1424,39 @@ const manifest &workbook::manifest() const
     return d_->manifest_;
 }
 
-const std::map<std::size_t, rich_text> &workbook::shared_strings_by_id() const
+const std::vector<rich_text> &workbook::shared_strings_by_id() const
 {
-    return d_->shared_strings_values_;
+    return d_->shared_strings_.strings();
 }
 
 const rich_text &workbook::shared_strings(std::size_t index) const
 {
-    auto it = d_->shared_strings_values_.find(index);
-
-    if (it != d_->shared_strings_values_.end())
+    if (index < d_->shared_strings_.size())
     {
-        return it->second;
+        return d_->shared_strings_[index];
     }
 
     static rich_text empty;
     return empty;
 }
 
-std::unordered_map<rich_text, std::size_t, rich_text_hash> &workbook::shared_strings()
+const std::vector<rich_text> &workbook::shared_strings() const
 {
-    return d_->shared_strings_ids_;
-}
-
-const std::unordered_map<rich_text, std::size_t, rich_text_hash> &workbook::shared_strings() const
-{
-    return d_->shared_strings_ids_;
+    return d_->shared_strings_.strings();
 }
 
 std::size_t workbook::add_shared_string(const rich_text &shared, bool allow_duplicates)
 {
     register_workbook_part(relationship_type::shared_string_table);
 
-    if (!allow_duplicates)
-    {
-        auto it = d_->shared_strings_ids_.find(shared);
-
-        if (it != d_->shared_strings_ids_.end())
-        {
-            return it->second;
-        }
-    }
-
-    auto sz = d_->shared_strings_ids_.size();
-    d_->shared_strings_ids_[shared] = sz;
-    d_->shared_strings_values_[sz] = shared;
-
-    return sz;
+    return d_->shared_strings_.add(shared, allow_duplicates);
 }
 
 bool workbook::contains(const std::string &sheet_title) const
 {
-    for (auto ws : *this)
+    for (const auto &impl : d_->worksheets_)
     {
-        if (ws.title() == sheet_title) return true;
+        if (impl.title_ == sheet_title) return true;
     }
 
     return false;
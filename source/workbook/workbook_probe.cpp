@@ -0,0 +1,265 @@
+// Copyright (c) 2016-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <fstream>
+#include <unordered_map>
+
+#include <xlnt/packaging/manifest.hpp>
+#include <xlnt/packaging/relationship.hpp>
+#include <xlnt/utils/exceptions.hpp>
+#include <xlnt/utils/path.hpp>
+#include <xlnt/workbook/workbook_probe.hpp>
+#include <detail/constants.hpp>
+#include <detail/external/include_libstudxml.hpp>
+#include <detail/serialization/custom_value_traits.hpp>
+#include <detail/serialization/open_stream.hpp>
+#include <detail/serialization/vector_streambuf.hpp>
+#include <detail/serialization/zstream.hpp>
+
+namespace {
+
+/// <summary>
+/// Returns the value of the attribute called name of the element parser is at,
+/// or an empty string if it doesn't have one.
+/// </summary>
+std::string attribute(const xml::parser &parser, const xml::qname &name)
+{
+    const auto &attributes = parser.attribute_map();
+    const auto match = attributes.find(name);
+
+    return match == attributes.end() ? std::string() : match->second.value;
+}
+
+/// <summary>
+/// Calls visit with parser positioned at each element of part in document order
+/// until visit returns false or the part ends.
+/// </summary>
+template <typename Visit>
+void visit_elements(const xlnt::detail::izstream &archive, const xlnt::path &part, Visit visit)
+{
+    auto part_streambuf = archive.open(part);
+    std::istream part_stream(part_streambuf.get());
+    xml::parser parser(part_stream, part.string());
+
+    for (auto event = parser.next(); event != xml::parser::eof; event = parser.next())
+    {
+        if (event != xml::parser::start_element)
+        {
+            continue;
+        }
+
+        // marks every attribute as handled so that the parser doesn't
+        // complain about the ones that aren't looked at
+        parser.attribute_map();
+
+        if (!visit(parser))
+        {
+            return;
+        }
+    }
+}
+
+xlnt::sheet_state to_sheet_state(const std::string &state)
+{
+    if (state == "hidden")
+    {
+        return xlnt::sheet_state::hidden;
+    }
+
+    return state == "veryHidden" ? xlnt::sheet_state::very_hidden : xlnt::sheet_state::visible;
+}
+
+} // namespace
+
+namespace xlnt {
+
+workbook_probe::workbook_probe(const std::vector<std::uint8_t> &data)
+{
+    detail::vector_istreambuf data_buffer(data);
+    std::istream data_stream(&data_buffer);
+    probe(data_stream);
+}
+
+workbook_probe::workbook_probe(const std::string &filename)
+    : workbook_probe(path(filename))
+{
+}
+
+#ifdef _MSC_VER
+workbook_probe::workbook_probe(const std::wstring &filename)
+{
+    std::ifstream file_stream;
+    detail::open_stream(file_stream, filename);
+
+    if (!file_stream.good())
+    {
+        throw xlnt::exception("file not found");
+    }
+
+    probe(file_stream);
+}
+#endif
+
+workbook_probe::workbook_probe(const path &filename)
+{
+    std::ifstream file_stream;
+    detail::open_stream(file_stream, filename.string());
+
+    if (!file_stream.good())
+    {
+        throw xlnt::exception("file not found " + filename.string());
+    }
+
+    probe(file_stream);
+}
+
+workbook_probe::workbook_probe(std::istream &stream)
+{
+    probe(stream);
+}
+
+const std::vector<sheet_summary> &workbook_probe::sheets() const
+{
+    return sheets_;
+}
+
+std::vector<std::string> workbook_probe::sheet_titles() const
+{
+    std::vector<std::string> titles;
+
+    for (const auto &sheet : sheets_)
+    {
+        titles.push_back(sheet.title);
+    }
+
+    return titles;
+}
+
+void workbook_probe::probe(std::istream &stream)
+{
+    const detail::izstream archive(stream);
+    const auto root = path("/");
+
+    // the workbook part is found through the package relationships, as load
+    // does, so that templates and workbooks under other names are found too
+    const auto &relationships_ns = constants::ns("relationships");
+    const auto office_document_type = detail::to_string(relationship_type::office_document);
+    auto workbook_target = path();
+
+    if (archive.has_file(path("_rels/.rels")))
+    {
+        visit_elements(archive, path("_rels/.rels"), [&](const xml::parser &parser) {
+            if (parser.qname() == xml::qname(relationships_ns, "Relationship")
+                && attribute(parser, xml::qname("Type")) == office_document_type)
+            {
+                workbook_target = path(attribute(parser, xml::qname("Target")));
+                return false;
+            }
+
+            return true;
+        });
+    }
+
+    if (workbook_target.string().empty())
+    {
+        throw xlnt::exception("missing workbook part");
+    }
+
+    const auto workbook_rel = relationship("rId1", relationship_type::office_document, uri("/"),
+        uri(workbook_target.is_absolute() ? workbook_target.relative_to(root).string() : workbook_target.string()),
+        target_mode::internal);
+    const auto workbook_path = manifest().canonicalize({workbook_rel});
+
+    // sheet relationship ids mapped to the parts they point to
+    std::unordered_map<std::string, path> sheet_parts;
+    const auto workbook_rels_path = workbook_path.parent().append("_rels").append(workbook_path.filename() + ".rels");
+
+    if (archive.has_file(workbook_rels_path))
+    {
+        visit_elements(archive, workbook_rels_path, [&](const xml::parser &parser) {
+            if (parser.qname() == xml::qname(relationships_ns, "Relationship"))
+            {
+                const auto id = attribute(parser, xml::qname("Id"));
+                const auto target = path(attribute(parser, xml::qname("Target")));
+                const auto sheet_rel = relationship(id, relationship_type::worksheet, uri(workbook_path.string()),
+                    uri(target.is_absolute() ? target.relative_to(workbook_path.parent().resolve(root)).string() : target.string()),
+                    target_mode::internal);
+
+                sheet_parts[id] = manifest().canonicalize({workbook_rel, sheet_rel});
+            }
+
+            return true;
+        });
+    }
+
+    const auto &workbook_ns = constants::ns("workbook");
+    const auto rel_id = xml::qname(constants::ns("r"), "id");
+    std::vector<std::string> sheet_rel_ids;
+
+    visit_elements(archive, workbook_path, [&](const xml::parser &parser) {
+        if (parser.qname() == xml::qname(workbook_ns, "sheet"))
+        {
+            sheet_summary sheet;
+            sheet.title = attribute(parser, xml::qname("name"));
+            sheet.id = std::stoul(attribute(parser, xml::qname("sheetId")));
+            sheet.state = to_sheet_state(attribute(parser, xml::qname("state")));
+            sheets_.push_back(sheet);
+            sheet_rel_ids.push_back(attribute(parser, rel_id));
+
+            return true;
+        }
+
+        // nothing of interest follows the sheet list
+        return sheets_.empty();
+    });
+
+    for (std::size_t index = 0; index < sheets_.size(); ++index)
+    {
+        auto sheet_part = sheet_parts.find(sheet_rel_ids[index]);
+
+        if (sheet_part == sheet_parts.end())
+        {
+            throw key_not_found();
+        }
+
+        auto &sheet = sheets_[index];
+        const auto &spreadsheetml_ns = constants::ns("spreadsheetml");
+
+        // dimension comes before everything but sheetPr, so this stops
+        // after inflating no more than the head of the part
+        visit_elements(archive, sheet_part->second, [&](const xml::parser &parser) {
+            if (parser.qname() == xml::qname(spreadsheetml_ns, "dimension"))
+            {
+                sheet.dimension = range_reference(attribute(parser, xml::qname("ref")));
+                sheet.row_count = sheet.dimension.get().bottom_right().row();
+
+                return false;
+            }
+
+            return parser.qname() != xml::qname(spreadsheetml_ns, "sheetData");
+        });
+    }
+}
+
+} // namespace xlnt
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 
 #include <xlnt/cell/cell.hpp>
 #include <xlnt/cell/cell_reference.hpp>
@@ -201,19 +202,9 @@ const workbook &worksheet::workbook() const
 
 void worksheet::garbage_collect()
 {
-    auto cell_iter = d_->cell_map_.begin();
-
-    while (cell_iter != d_->cell_map_.end())
-    {
-        if (xlnt::cell(&cell_iter->second).garbage_collectible())
-        {
-            cell_iter = d_->cell_map_.erase(cell_iter);
-        }
-        else
-        {
-            ++cell_iter;
-        }
-    }
+    d_->cell_map_.erase_if([](const detail::cell_impl &cell) {
+        return cell.is_garbage_collectible();
+    });
 }
 
 void worksheet::id(std::size_t id)
@@ -382,22 +373,26 @@ cell_reference worksheet::active_cell() const
 
 cell worksheet::cell(const cell_reference &reference)
 {
-    auto match = d_->cell_map_.find(reference);
-    if (match == d_->cell_map_.end())
-    {
-        auto impl = detail::cell_impl();
-        impl.parent_ = d_;
-        impl.column_ = reference.column_index();
-        impl.row_ = reference.row();
+    auto match = d_->cell_map_.emplace(reference.column(), reference.row());
 
-        match = d_->cell_map_.emplace(reference, impl).first;
+    if (match.second)
+    {
+        match.first->parent_ = d_;
     }
-    return xlnt::cell(&match->second);
+
+    return xlnt::cell(match.first);
 }
 
 const cell worksheet::cell(const cell_reference &reference) const
 {
-    return xlnt::cell(&d_->cell_map_.at(reference));
+    auto match = d_->cell_map_.find(reference.column(), reference.row());
+
+    if (match == nullptr)
+    {
+        throw std::out_of_range("cell " + reference.to_string() + " doesn't exist");
+    }
+
+    return xlnt::cell(match);
 }
 
 cell worksheet::cell(xlnt::column_t column, row_t row)
@@ -412,8 +407,7 @@ const cell worksheet::cell(xlnt::column_t column, row_t row) const
 
 bool worksheet::has_cell(const cell_reference &reference) const
 {
-    const auto cell = d_->cell_map_.find(reference);
-    return cell != d_->cell_map_.cend();
+    return d_->cell_map_.find(reference.column(), reference.row()) != nullptr;
 }
 
 bool worksheet::has_row_properties(row_t row) const
@@ -458,14 +452,7 @@ column_t worksheet::lowest_column() const
         return constants::min_column();
     }
 
-    auto lowest = constants::max_column();
-
-    for (auto &cell : d_->cell_map_)
-    {
-        lowest = std::min(lowest, cell.first.column());
-    }
-
-    return lowest;
+    return d_->cell_map_.lowest_column();
 }
 
 column_t worksheet::lowest_column_or_props() const
@@ -492,14 +479,7 @@ row_t worksheet::lowest_row() const
         return constants::min_row();
     }
 
-    auto lowest = constants::max_row();
-
-    for (auto &cell : d_->cell_map_)
-    {
-        lowest = std::min(lowest, cell.first.row());
-    }
-
-    return lowest;
+    return d_->cell_map_.lowest_row();
 }
 
 row_t worksheet::lowest_row_or_props() const
@@ -521,14 +501,12 @@ row_t worksheet::lowest_row_or_props() const
 
 row_t worksheet::highest_row() const
 {
-    auto highest = constants::min_row();
-
-    for (auto &cell : d_->cell_map_)
+    if (d_->cell_map_.empty())
     {
-        highest = std::max(highest, cell.first.row());
+        return constants::min_row();
     }
 
-    return highest;
+    return d_->cell_map_.highest_row();
 }
 
 row_t worksheet::highest_row_or_props() const
@@ -550,14 +528,12 @@ row_t worksheet::highest_row_or_props() const
 
 column_t worksheet::highest_column() const
 {
-    auto highest = constants::min_column();
-
-    for (auto &cell : d_->cell_map_)
+    if (d_->cell_map_.empty())
     {
-        highest = std::max(highest, cell.first.column());
+        return constants::min_column();
     }
 
-    return highest;
+    return d_->cell_map_.highest_column();
 }
 
 column_t worksheet::highest_column_or_props() const
@@ -600,19 +576,10 @@ range_reference worksheet::calculate_dimension() const
         return range_reference(constants::min_column(), min_row_prop,
             constants::min_column(), max_row_prop);
     }
-    // find min and max row/column in cell map
-    column_t min_col = constants::max_column();
-    column_t max_col = constants::min_column();
-    row_t min_row = min_row_prop;
-    row_t max_row = max_row_prop;
-    for (auto &c : d_->cell_map_)
-    {
-        min_col = std::min(min_col, c.second.column_);
-        max_col = std::max(max_col, c.second.column_);
-        min_row = std::min(min_row, c.second.row_);
-        max_row = std::max(max_row, c.second.row_);
-    }
-    return range_reference(min_col, min_row, max_col, max_row);
+    // the cell store keeps its bounds up to date as cells come and go
+    const auto &cells = d_->cell_map_;
+    return range_reference(cells.lowest_column(), std::min(min_row_prop, cells.lowest_row()),
+        cells.highest_column(), std::max(max_row_prop, cells.highest_row()));
 }
 
 range worksheet::range(const std::string &reference_string)
@@ -753,23 +720,13 @@ const cell_vector worksheet::cells(bool skip_null) const
 
 void worksheet::clear_cell(const cell_reference &ref)
 {
-    d_->cell_map_.erase(ref);
+    d_->cell_map_.erase(ref.column(), ref.row());
     // TODO: garbage collect newly unreferenced resources such as styles?
 }
 
 void worksheet::clear_row(row_t row)
 {
-    for (auto it = d_->cell_map_.begin(); it != d_->cell_map_.end();)
-    {
-        if (it->first.row() == row)
-        {
-            it = d_->cell_map_.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
-    }
+    d_->cell_map_.erase_row(row);
     d_->row_properties_.erase(row);
     // TODO: garbage collect newly unreferenced resources such as styles?
 }
@@ -808,17 +765,15 @@ void worksheet::move_cells(std::uint32_t min_index, std::uint32_t amount, row_or
 
     std::vector<detail::cell_impl> cells_to_move;
 
-    auto cell_iter = d_->cell_map_.cbegin();
-    while (cell_iter != d_->cell_map_.cend())
-    {
+    d_->cell_map_.erase_if([&](detail::cell_impl &cell) {
         std::uint32_t current_index;
         switch (row_or_col)
         {
         case row_or_col_t::row:
-            current_index = cell_iter->first.row();
+            current_index = cell.row_;
             break;
         case row_or_col_t::column:
-            current_index = cell_iter->first.column().index;
+            current_index = cell.column_.index;
             break;
         default:
             throw xlnt::unhandled_switch_case();
@@ -826,32 +781,31 @@ void worksheet::move_cells(std::uint32_t min_index, std::uint32_t amount, row_or
 
         if (current_index >= min_index) // extract cells to be moved
         {
-            auto cell = cell_iter->second;
+            // like other formulae, a moved shared formula keeps its text
+            cell.unshare_formula();
+
+            auto moved = cell;
             if (row_or_col == row_or_col_t::row)
             {
-                cell.row_ = reverse ? cell.row_ - amount : cell.row_ + amount;
+                moved.row_ = reverse ? moved.row_ - amount : moved.row_ + amount;
             }
             else if (row_or_col == row_or_col_t::column)
             {
-                cell.column_ = reverse ? cell.column_.index - amount : cell.column_.index + amount;
+                moved.column_ = reverse ? moved.column_.index - amount : moved.column_.index + amount;
             }
 
-            cells_to_move.push_back(cell);
-            cell_iter = d_->cell_map_.erase(cell_iter);
+            cells_to_move.push_back(moved);
+            cell.extras_ = 0; // the side table entry now belongs to the moved copy
+            return true;
         }
-        else if (reverse && current_index >= min_index - amount) // delete destination cells
-        {
-            cell_iter = d_->cell_map_.erase(cell_iter);
-        }
-        else // skip other cells
-        {
-            ++cell_iter;
-        }
-    }
+
+        // delete destination cells, skip other cells
+        return reverse && current_index >= min_index - amount;
+    });
 
     for (auto &cell : cells_to_move)
     {
-        d_->cell_map_[cell_reference(cell.column_, cell.row_)] = cell;
+        *d_->cell_map_.emplace(cell.column_, cell.row_).first = cell;
     }
 
     if (row_or_col == row_or_col_t::row)
@@ -962,13 +916,15 @@ bool worksheet::compare(const worksheet &other, bool reference) const
 
     for (auto &cell : d_->cell_map_)
     {
-        if (other.d_->cell_map_.find(cell.first) == other.d_->cell_map_.end())
+        auto other_impl = other.d_->cell_map_.find(cell.column_, cell.row_);
+
+        if (other_impl == nullptr)
         {
             return false;
         }
 
-        xlnt::cell this_cell(&cell.second);
-        xlnt::cell other_cell(&other.d_->cell_map_[cell.first]);
+        xlnt::cell this_cell(&cell);
+        xlnt::cell other_cell(other_impl);
 
         if (this_cell.data_type() != other_cell.data_type())
         {
@@ -38,6 +38,7 @@ public:
         register_test(test_runs);
         register_test(test_phonetic_runs);
         register_test(test_phonetic_properties);
+        register_test(test_plain_text_becomes_runs);
     }
 
     void test_operators()
@@ -142,5 +143,32 @@ public:
         xlnt_assert_equals(rt.phonetic_properties().has_type(), true);
         xlnt_assert_equals(rt.phonetic_properties().has_alignment(), true);
     }
+
+    void test_plain_text_becomes_runs()
+    {
+        xlnt::rich_text plain("abc");
+        xlnt::rich_text from_run(xlnt::rich_text_run{"abc", {}, false});
+        xlnt_assert_equals(plain, from_run);
+        xlnt_assert_equals(plain, std::string("abc"));
+        xlnt_assert_equals(xlnt::rich_text_hash()(plain), xlnt::rich_text_hash()(from_run));
+        xlnt_assert_differs(plain, xlnt::rich_text());
+        xlnt_assert_differs(xlnt::rich_text(""), xlnt::rich_text());
+
+        xlnt::rich_text_run bold{"def", xlnt::font().bold(true), false};
+        plain.add_run(bold);
+        xlnt_assert_equals(plain.runs().size(), 2);
+        xlnt_assert_equals(plain.runs()[0], (xlnt::rich_text_run{"abc", {}, false}));
+        xlnt_assert_equals(plain.runs()[1], bold);
+        xlnt_assert_equals(plain.plain_text(), "abcdef");
+        xlnt_assert_differs(plain, std::string("abcdef"));
+
+        xlnt::rich_text replaced;
+        replaced.runs(plain.runs());
+        xlnt_assert_equals(replaced, plain);
+        replaced.runs({xlnt::rich_text_run{"abc", {}, false}});
+        xlnt_assert_equals(replaced, from_run);
+        xlnt_assert_equals(xlnt::rich_text(" x "), std::string(" x "));
+        xlnt_assert_equals(xlnt::rich_text(" x ").runs()[0].preserve_space, true);
+    }
 };
 static rich_text_test_suite x{};
@@ -0,0 +1,166 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <functional>
+#include <string>
+
+#include <detail/implementations/arena.hpp>
+#include <detail/implementations/cell_impl.hpp>
+#include <detail/implementations/worksheet_impl.hpp>
+#include <helpers/test_suite.hpp>
+
+class arena_test_suite : public test_suite
+{
+public:
+    arena_test_suite()
+    {
+        register_test(test_string_arena_store);
+        register_test(test_string_arena_assign);
+        register_test(test_string_arena_compact);
+        register_test(test_released_formulae_reclaimed);
+        register_test(test_chunked_table_stable);
+        register_test(test_chunked_table_reuse);
+    }
+
+    void test_string_arena_store()
+    {
+        xlnt::detail::string_arena arena;
+        auto first = arena.store("SUM(A1:A2)", 10);
+        auto second = arena.store("", 0);
+        auto third = arena.store("B1*2", 4);
+
+        xlnt_assert_equals(arena.get(first), "SUM(A1:A2)");
+        xlnt_assert_equals(arena.get(second), "");
+        xlnt_assert_equals(arena.get(third), "B1*2");
+        xlnt_assert(arena.equals(third, "B1*2", 4));
+        xlnt_assert(!arena.equals(third, "B1*3", 4));
+
+        // handles are offsets so they stay valid in copies
+        auto copy = arena;
+        arena.clear();
+        xlnt_assert_equals(copy.get(first), "SUM(A1:A2)");
+    }
+
+    void test_string_arena_assign()
+    {
+        xlnt::detail::string_arena arena;
+        auto handle = arena.store("LONGER(A1)", 10);
+        auto original_offset = handle.offset;
+
+        arena.assign(handle, "A1", 2);
+        xlnt_assert_equals(handle.offset, original_offset);
+        xlnt_assert_equals(arena.get(handle), "A1");
+
+        arena.assign(handle, "MUCH_LONGER(A1)", 15);
+        xlnt_assert_differs(handle.offset, original_offset);
+        xlnt_assert_equals(arena.get(handle), "MUCH_LONGER(A1)");
+    }
+
+    void test_string_arena_compact()
+    {
+        xlnt::detail::string_arena arena;
+        const auto long_text = std::string(5000, 'x');
+        auto kept = arena.store("SUM(A1:A2)", 10);
+        auto released = arena.store(long_text.data(), long_text.size());
+
+        xlnt_assert(!arena.fragmented());
+        arena.release(released);
+        xlnt_assert(arena.fragmented());
+
+        arena.compact([&kept](const std::function<void(xlnt::detail::string_arena::handle &)> &relocate) {
+            relocate(kept);
+        });
+
+        xlnt_assert(!arena.fragmented());
+        xlnt_assert_equals(arena.size(), 10u);
+        xlnt_assert_equals(kept.offset, 0u);
+        xlnt_assert_equals(arena.get(kept), "SUM(A1:A2)");
+    }
+
+    void test_released_formulae_reclaimed()
+    {
+        xlnt::detail::worksheet_impl sheet(nullptr, 1, "Sheet1");
+        xlnt::detail::cell_impl kept;
+        kept.parent_ = &sheet;
+        kept.formula("SUM(A1:A2)", 10);
+
+        // one cell reused for many formulae, as the streaming reader and writer do
+        xlnt::detail::cell_impl reused;
+        reused.parent_ = &sheet;
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            const auto text = "B" + std::to_string(i) + "*2";
+            reused.formula(text.data(), text.size());
+
+            if (i % 2 == 0)
+            {
+                reused.clear_formula();
+            }
+            else
+            {
+                reused.release_extras();
+            }
+        }
+
+        xlnt_assert(sheet.formulae_.size() < 10000);
+        xlnt_assert_equals(kept.formula(), "SUM(A1:A2)");
+    }
+
+    void test_chunked_table_stable()
+    {
+        xlnt::detail::chunked_table<std::string> table;
+        auto first = table.allocate();
+        table[first] = "first";
+        auto *address = &table[first];
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            table[table.allocate()] = std::to_string(i);
+        }
+
+        xlnt_assert_equals(&table[first], address);
+        xlnt_assert_equals(table[first], "first");
+
+        auto copy = table;
+        xlnt_assert_equals(copy[first], "first");
+        xlnt_assert_differs(&copy[first], address);
+    }
+
+    void test_chunked_table_reuse()
+    {
+        xlnt::detail::chunked_table<std::string> table;
+        auto first = table.allocate();
+        auto second = table.allocate();
+        table[first] = "a";
+        table[second] = "b";
+
+        xlnt_assert_differs(first, 0u);
+        table.release(first);
+        xlnt_assert_equals(table[first], "");
+        xlnt_assert_equals(table.allocate(), first);
+        xlnt_assert_equals(table[second], "b");
+    }
+};
+static arena_test_suite x;
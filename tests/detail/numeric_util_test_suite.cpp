@@ -21,6 +21,12 @@
 // @license: http://www.opensource.org/licenses/mit-license.php
 // @author: see AUTHORS file
 
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
 #include <xlnt/utils/numeric.hpp>
 #include <helpers/test_suite.hpp>
 
@@ -30,6 +36,9 @@ public:
     numeric_test_suite()
     {
         register_test(test_serialise_number);
+        register_test(test_serialise_number_matches_printf);
+        register_test(test_deserialise_number);
+        register_test(test_parse_double_round_trip);
         register_test(test_float_equals_zero);
         register_test(test_float_equals_large);
         register_test(test_float_equals_fairness);
@@ -54,6 +63,99 @@ public:
         xlnt_assert(serialiser.serialise(1.23456789012345e-67) == "1.23456789012345e-67");
     }
 
+    void test_serialise_number_matches_printf()
+    {
+        xlnt::detail::number_serialiser serialiser;
+        xlnt_assert_equals(serialiser.serialise(0.0), "0");
+        xlnt_assert_equals(serialiser.serialise(-0.0), "-0");
+        xlnt_assert_equals(serialiser.serialise(1e14), "100000000000000");
+        xlnt_assert_equals(serialiser.serialise(1e15), "1e+15");
+        xlnt_assert_equals(serialiser.serialise(999999999999999.9), "1e+15");
+        xlnt_assert_equals(serialiser.serialise(0.0001), "0.0001");
+        xlnt_assert_equals(serialiser.serialise(0.00001), "1e-05");
+        xlnt_assert_equals(serialiser.serialise(0.1 + 0.2), "0.3");
+        xlnt_assert_equals(serialiser.serialise(1.7976931348623157e308), "1.79769313486232e+308");
+        xlnt_assert_equals(serialiser.serialise(4.9406564584124654e-324), "4.94065645841247e-324");
+        // exactly halfway between two 15 digit values, rounded to even
+        xlnt_assert_equals(serialiser.serialise(1234567890123465.0), "1.23456789012346e+15");
+
+        std::string reused;
+        serialiser.serialise(-123456.789012345, reused);
+        xlnt_assert_equals(reused, "-123456.789012345");
+
+        std::mt19937_64 generator(20202);
+        char expected[64];
+
+        for (auto i = 0; i < 100000; ++i)
+        {
+            auto bits = generator();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            for (auto candidate : {value, std::ldexp(static_cast<double>(bits >> 11), -20)})
+            {
+                std::snprintf(expected, sizeof(expected), "%.15g", candidate);
+                xlnt_assert_equals(serialiser.serialise(candidate), expected);
+            }
+        }
+    }
+
+    void test_deserialise_number()
+    {
+        xlnt::detail::number_serialiser serialiser;
+        xlnt_assert_equals(serialiser.deserialise(std::string("1")), 1.0);
+        xlnt_assert_equals(serialiser.deserialise(std::string("-1.5")), -1.5);
+        xlnt_assert_equals(serialiser.deserialise(std::string("1.23456789012345E+67")), 1.23456789012345e+67);
+        xlnt_assert_equals(serialiser.deserialise(std::string("0.30000000000000004")), 0.1 + 0.2);
+        xlnt_assert_equals(serialiser.deserialise(std::string("9007199254740993")), 9007199254740992.0);
+        xlnt_assert_equals(serialiser.deserialise(std::string("4.9406564584124654e-324")), 4.9406564584124654e-324);
+        xlnt_assert_equals(serialiser.deserialise(std::string("1e-400")), 0.0);
+        xlnt_assert_equals(serialiser.deserialise(std::string("1.7976931348623157e308")), 1.7976931348623157e308);
+        // more digits than are kept, halfway between 1 and the next double
+        xlnt_assert_equals(serialiser.deserialise(std::string("1.00000000000000011102230246251565404236316680908203125")), 1.0);
+        xlnt_assert_equals(serialiser.deserialise(std::string("1.00000000000000011102230246251565404236316680908203126")), 1.0000000000000002);
+        // anything else still goes through strtod
+        xlnt_assert_equals(serialiser.deserialise(std::string(" 12")), 12.0);
+        xlnt_assert_equals(serialiser.deserialise(std::string("12px")), 12.0);
+
+        double result = 42.0;
+        xlnt_assert(!xlnt::detail::parse_double("", "", result));
+        for (auto text : {"-", ".", "e5", "1e", "1e+", " 1", "1 ", "nan", "inf", "0x10", "1,5"})
+        {
+            xlnt_assert(!xlnt::detail::parse_double(text, text + std::strlen(text), result));
+        }
+        xlnt_assert_equals(result, 42.0);
+    }
+
+    void test_parse_double_round_trip()
+    {
+        std::mt19937_64 generator(20201);
+        char buffer[64];
+
+        for (auto i = 0; i < 100000; ++i)
+        {
+            auto bits = generator();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            if (!(value - value == 0))
+            {
+                continue; // infinity or NaN
+            }
+
+            for (auto format : {"%.17g", "%.15g", "%.25e"})
+            {
+                std::snprintf(buffer, sizeof(buffer), format, value);
+                double parsed;
+
+                if (xlnt::detail::parse_double(buffer, buffer + std::strlen(buffer), parsed))
+                {
+                    xlnt_assert_equals(parsed, std::strtod(buffer, nullptr));
+                }
+            }
+        }
+    }
+
     void test_float_equals_zero()
     {
         // comparing relatively small numbers (2.3e-6) with 0 will be true by default
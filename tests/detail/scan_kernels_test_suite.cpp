@@ -0,0 +1,81 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <string>
+
+#include <detail/serialization/scan_kernels.hpp>
+#include <helpers/test_suite.hpp>
+
+class scan_kernels_test_suite : public test_suite
+{
+public:
+    scan_kernels_test_suite()
+    {
+        register_test(test_kernels_match_scalar);
+    }
+
+    void test_kernels_match_scalar()
+    {
+        using namespace xlnt::detail;
+
+        // every byte value at every offset of ranges that end inside, on and
+        // past a vector boundary, with a UTF-8 sequence in the middle
+        for (auto length = std::size_t(0); length < 40; ++length)
+        {
+            for (auto offset = std::size_t(0); offset < length; ++offset)
+            {
+                for (auto value = 0; value < 256; value += 3)
+                {
+                    auto text = std::string(length, '7');
+
+                    if (length >= 4)
+                    {
+                        text[length / 2] = '\xCE';
+                        text[length / 2 + 1] = '\x9B';
+                    }
+
+                    text[offset] = static_cast<char>(value);
+
+                    const auto begin = text.data();
+                    const auto end = begin + text.size();
+
+                    xlnt_assert_equals(find_byte(begin, end, '<'), scalar_find_byte(begin, end, '<'));
+                    xlnt_assert_equals(find_byte(begin, end, '\xCE'), scalar_find_byte(begin, end, '\xCE'));
+                    xlnt_assert_equals(find_text_break(begin, end), scalar_find_text_break(begin, end));
+                    xlnt_assert_equals(skip_digits(begin, end), scalar_skip_digits(begin, end));
+                }
+            }
+        }
+
+        const auto text = std::string("<c r=\"A1\"><v>12345678901234567890.5</v></c>");
+        const auto begin = text.data();
+        const auto end = begin + text.size();
+
+        xlnt_assert_equals(find_byte(begin, end, '>') - begin, 9);
+        xlnt_assert_equals(find_text_break(begin + 13, end) - begin, 35);
+        xlnt_assert_equals(skip_digits(begin + 13, end) - begin, 33);
+        xlnt_assert_equals(find_byte(begin, end, '&'), end);
+    }
+};
+static scan_kernels_test_suite x;
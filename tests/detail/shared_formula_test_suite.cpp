@@ -0,0 +1,55 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <string>
+
+#include <detail/implementations/shared_formula.hpp>
+#include <helpers/test_suite.hpp>
+
+class shared_formula_test_suite : public test_suite
+{
+public:
+    shared_formula_test_suite()
+    {
+        register_test(test_shift_formula);
+    }
+
+    void test_shift_formula()
+    {
+        using xlnt::detail::shift_formula;
+
+        xlnt_assert_equals(shift_formula("A1+B2", 0, 0), "A1+B2");
+        xlnt_assert_equals(shift_formula("A1+B2", 2, 1), "B3+C4");
+        xlnt_assert_equals(shift_formula("$A1+A$1+$A$1", 1, 1), "$A2+B$1+$A$1");
+        xlnt_assert_equals(shift_formula("SUM(a1:Z99)*2.5", 1, 0), "SUM(A2:Z100)*2.5");
+        xlnt_assert_equals(shift_formula("Sheet2!A1+'My Sheet'!B1", 1, 0), "Sheet2!A2+'My Sheet'!B2");
+        xlnt_assert_equals(shift_formula("SUM(A:B)+SUM(1:$2)", 3, 2), "SUM(C:D)+SUM(4:$2)");
+        xlnt_assert_equals(shift_formula("LOG10(A1)&\"A1\"\"B1\"", 1, 0), "LOG10(A2)&\"A1\"\"B1\"");
+        xlnt_assert_equals(shift_formula("Table1[[#This Row],[A1]]+total", 1, 0), "Table1[[#This Row],[A1]]+total");
+        xlnt_assert_equals(shift_formula("A1+XFD1048576", 0, 0), "A1+XFD1048576");
+        xlnt_assert_equals(shift_formula("A1+XFD1", 0, 1), "B1+#REF!");
+        xlnt_assert_equals(shift_formula("B2", -2, 0), "#REF!");
+    }
+};
+static shared_formula_test_suite x;
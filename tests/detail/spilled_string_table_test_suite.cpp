@@ -0,0 +1,78 @@
+// Copyright (c) 2014-2020 Thomas Fussell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, WRISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE
+//
+// @license: http://www.opensource.org/licenses/mit-license.php
+// @author: see AUTHORS file
+
+
+#include <string>
+#include <vector>
+
+#include <detail/implementations/spilled_string_table.hpp>
+#include <helpers/test_suite.hpp>
+
+class spilled_string_table_test_suite : public test_suite
+{
+public:
+    spilled_string_table_test_suite()
+    {
+        register_test(test_add_and_read_back);
+    }
+
+    void test_add_and_read_back()
+    {
+        xlnt::detail::spilled_string_table table;
+
+        xlnt_assert_equals(table.add("first"), 0);
+        xlnt_assert_equals(table.add(""), 1);
+        xlnt_assert_equals(table.add("first"), 0);
+
+        // enough strings to be flushed to the file several times, grow the
+        // index and push early strings out of the cache, some too long to be cached
+        const auto long_text = std::string(300, 'x');
+
+        for (auto i = 0; i < 20000; ++i)
+        {
+            const auto text = (i % 100 == 0 ? long_text : std::string("string ")) + std::to_string(i);
+            xlnt_assert_equals(table.add(text), i + 2);
+        }
+
+        xlnt_assert_equals(table.add("first"), 0);
+        xlnt_assert_equals(table.add("string 1"), 3);
+        xlnt_assert_equals(table.add(long_text + "0"), 2);
+        xlnt_assert_equals(table.add(long_text + "19900"), 19902);
+        xlnt_assert_equals(table.add("string 19999"), 20001);
+        xlnt_assert_equals(table.size(), 20002);
+
+        std::vector<std::string> strings;
+        table.for_each([&strings](const std::string &text) { strings.push_back(text); });
+
+        xlnt_assert_equals(strings.size(), 20002);
+        xlnt_assert_equals(strings[0], "first");
+        xlnt_assert_equals(strings[1], "");
+        xlnt_assert_equals(strings[2], long_text + "0");
+        xlnt_assert_equals(strings[20001], "string 19999");
+
+        // adding after reading everything back
+        xlnt_assert_equals(table.add("last"), 20002);
+        xlnt_assert_equals(table.add("string 5"), 7);
+    }
+};
+static spilled_string_table_test_suite x;
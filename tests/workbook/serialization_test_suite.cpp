@@ -22,6 +22,7 @@
 // @author: see AUTHORS file
 
 #include <iostream>
+#include <sstream>
 
 #include <xlnt/cell/comment.hpp>
 #include <xlnt/cell/hyperlink.hpp>
@@ -40,7 +41,10 @@
 #include <xlnt/workbook/streaming_workbook_reader.hpp>
 #include <xlnt/workbook/streaming_workbook_writer.hpp>
 #include <xlnt/workbook/workbook.hpp>
+#include <xlnt/workbook/workbook_probe.hpp>
 #include <xlnt/workbook/metadata_property.hpp>
+#include <xlnt/workbook/row_buffer.hpp>
+#include <xlnt/workbook/workbook_view.hpp>
 #include <xlnt/worksheet/column_properties.hpp>
 #include <xlnt/worksheet/row_properties.hpp>
 #include <xlnt/worksheet/sheet_format_properties.hpp>
@@ -48,6 +52,7 @@
 #include <xlnt/worksheet/worksheet.hpp>
 #include <detail/cryptography/xlsx_crypto_consumer.hpp>
 #include <detail/serialization/vector_streambuf.hpp>
+#include <detail/serialization/zstream.hpp>
 #include <helpers/path_helper.hpp>
 #include <helpers/temporary_file.hpp>
 #include <helpers/test_suite.hpp>
@@ -89,10 +94,26 @@ public:
         register_test(test_round_trip_rw_encrypted_standard);
         register_test(test_round_trip_rw_encrypted_numbers);
         register_test(test_streaming_read);
+        register_test(test_streaming_read_matches_load);
+        register_test(test_streaming_read_rows);
         register_test(test_streaming_write);
+        register_test(test_streaming_write_rows);
+        register_test(test_streaming_write_failure);
+        register_test(test_streaming_write_spilled_strings);
         register_test(test_load_save_german_locale);
         register_test(test_Issue445_inline_str_load);
         register_test(test_Issue445_inline_str_streaming_read);
+        register_test(test_round_trip_sparse_wide_sheet);
+        register_test(test_load_worksheets_concurrently);
+        register_test(test_load_sheet_data_in_batches);
+        register_test(test_load_row_larger_than_batch);
+        register_test(test_load_hand_written_sheet_data);
+        register_test(test_round_trip_shared_formulae);
+        register_test(test_load_selected_parts);
+        register_test(test_load_selected_sheets_active_tab);
+        register_test(test_load_cell_window);
+        register_test(test_load_worksheets_lazily);
+        register_test(test_probe_workbook);
     }
 
     bool workbook_matches_file(xlnt::workbook &wb, const xlnt::path &file)
@@ -107,6 +128,40 @@ public:
         return xml_helper::xlsx_archives_match(wb_data, file_data);
     }
 
+    bool workbooks_match(xlnt::workbook &left, xlnt::workbook &right)
+    {
+        std::vector<std::uint8_t> left_data;
+        left.save(left_data);
+        std::vector<std::uint8_t> right_data;
+        right.save(right_data);
+
+        return xml_helper::xlsx_archives_match(left_data, right_data);
+    }
+
+    std::vector<std::uint8_t> replace_part(const std::vector<std::uint8_t> &archive, const xlnt::path &part, const std::string &content)
+    {
+        xlnt::detail::vector_istreambuf source_buffer(archive);
+        std::istream source_stream(&source_buffer);
+        xlnt::detail::izstream source(source_stream);
+
+        std::vector<std::uint8_t> result;
+        xlnt::detail::vector_ostreambuf destination_buffer(result);
+        std::ostream destination_stream(&destination_buffer);
+
+        {
+            xlnt::detail::ozstream destination(destination_stream);
+
+            for (const auto &file : source.files())
+            {
+                auto file_buffer = destination.open(file);
+                std::ostream file_stream(file_buffer.get());
+                file_stream << (file == part ? content : source.read(file));
+            }
+        }
+
+        return result;
+    }
+
     void test_produce_empty()
     {
         xlnt::workbook wb;
@@ -695,6 +750,175 @@ public:
         }
     }
 
+    void test_streaming_read_matches_load()
+    {
+        xlnt::workbook wb;
+        auto large = wb.active_sheet();
+        large.title("Large");
+
+        // enough rows for sheetData to be scanned in several batches
+        for (xlnt::row_t row = 1; row <= 5000; ++row)
+        {
+            large.cell(1, row).value(static_cast<int>(row) * 0.5);
+            large.cell(2, row).value("text " + std::to_string(row % 100));
+            large.cell(3, row).value(row % 2 == 0);
+            large.cell(4, row).formula("=A" + std::to_string(row) + "*2");
+        }
+
+        large.cell("B7").font(xlnt::font().bold(true));
+        large.row_properties(9).height = 30.0;
+        large.row_properties(9).custom_height = true;
+
+        auto small = wb.create_sheet();
+        small.title("Small");
+        small.cell("A1").value("first");
+        small.cell("C3").value(3);
+        small.merge_cells("A5:B6");
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        const auto loaded_large = loaded.sheet_by_title("Large");
+
+        xlnt::streaming_workbook_reader reader;
+        reader.open(buffer);
+        reader.begin_worksheet("Large");
+        std::size_t count = 0;
+
+        while (reader.has_cell())
+        {
+            const auto streamed = reader.read_cell();
+            const auto expected = loaded_large.cell(streamed.reference());
+            ++count;
+
+            xlnt_assert_equals(streamed.data_type(), expected.data_type());
+            xlnt_assert_equals(streamed.to_string(), expected.to_string());
+            xlnt_assert_equals(streamed.has_formula(), expected.has_formula());
+            xlnt_assert_equals(streamed.has_format(), expected.has_format());
+
+            if (streamed.has_formula())
+            {
+                xlnt_assert_equals(streamed.formula(), expected.formula());
+            }
+
+            if (streamed.has_format())
+            {
+                xlnt_assert_equals(streamed.format().font(), expected.format().font());
+            }
+        }
+
+        xlnt_assert_equals(count, 20000);
+        xlnt_assert(!reader.has_cell());
+        const auto streamed_large = reader.end_worksheet();
+        xlnt_assert_equals(streamed_large.row_properties(9).height.get(), 30.0);
+
+        // ending a worksheet early skips the cells that weren't read
+        reader.begin_worksheet("Small");
+        xlnt_assert(reader.has_cell());
+        xlnt_assert_equals(reader.read_cell().value<std::string>(), "first");
+        const auto streamed_small = reader.end_worksheet();
+        xlnt_assert_equals(streamed_small.merged_ranges().size(), 1);
+        xlnt_assert_equals(streamed_small.merged_ranges().front(), xlnt::range_reference("A5:B6"));
+    }
+
+    void test_streaming_read_rows()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        ws.cell("A1").value("name");
+        ws.cell("B1").value(1.5);
+        ws.cell("D1").value(true);
+        ws.cell("E1").error("#N/A");
+        ws.cell("B1").font(xlnt::font().bold(true));
+        ws.row_properties(2).height = 25.0; // a row without cells
+
+        for (xlnt::row_t row = 3; row <= 3000; ++row)
+        {
+            ws.cell(1, row).value(static_cast<int>(row));
+            ws.cell(3, row).value("text " + std::to_string(row % 10));
+        }
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        const auto loaded_ws = loaded.active_sheet();
+
+        xlnt::streaming_workbook_reader reader;
+        reader.open(buffer);
+        reader.begin_worksheet("Sheet1");
+
+        xlnt::row_buffer row;
+        xlnt_assert(reader.read_row(row));
+        xlnt_assert_equals(row.size(), 4);
+        xlnt_assert_equals(row.columns, std::vector<xlnt::column_t::index_t>({1, 2, 4, 5}));
+        xlnt_assert_equals(row.rows, std::vector<xlnt::row_t>(4, 1));
+        xlnt_assert_equals(row.types[0], xlnt::cell_type::shared_string);
+        xlnt_assert_equals(reader.workbook().shared_strings(row.shared_strings[0]).plain_text(), "name");
+        xlnt_assert_equals(row.types[1], xlnt::cell_type::number);
+        xlnt_assert_equals(row.numbers[1], 1.5);
+        xlnt_assert(reader.workbook().format(row.formats[1].get()).font().bold());
+        xlnt_assert_equals(row.types[2], xlnt::cell_type::boolean);
+        xlnt_assert_equals(row.numbers[2], 1.0);
+        xlnt_assert_equals(row.types[3], xlnt::cell_type::error);
+        xlnt_assert_equals(row.text(3), "#N/A");
+        xlnt_assert_equals(std::string(row.text_data(3), row.text_sizes[3]), "#N/A");
+
+        xlnt_assert_equals(row.last_row, 1);
+
+        xlnt_assert(reader.read_row(row));
+        xlnt_assert(row.empty());
+        xlnt_assert_equals(row.last_row, 2);
+
+        // a row partly read by read_cell is finished by read_row
+        xlnt_assert_equals(reader.read_cell().value<int>(), 3);
+        xlnt_assert(reader.read_row(row));
+        xlnt_assert_equals(row.columns, std::vector<xlnt::column_t::index_t>({3}));
+        xlnt_assert_equals(row.last_row, 3);
+
+        // even after read_cell has gone past the end of a row
+        xlnt_assert_equals(reader.read_cell().value<int>(), 4);
+        xlnt_assert_equals(reader.read_cell().value<std::string>(), "text 4");
+        xlnt_assert_equals(reader.read_cell().value<int>(), 5);
+        xlnt_assert(reader.read_row(row));
+        xlnt_assert_equals(row.rows, std::vector<xlnt::row_t>({5}));
+        xlnt_assert_equals(row.columns, std::vector<xlnt::column_t::index_t>({3}));
+        xlnt_assert_equals(row.last_row, 5);
+
+        xlnt::row_buffer batch;
+        auto rows = std::size_t(0);
+
+        for (auto read = reader.read_rows(1000, batch); read > 0; read = reader.read_rows(1000, batch))
+        {
+            rows += read;
+            xlnt_assert_equals(batch.size(), read * 2);
+
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                const auto expected = loaded_ws.cell(batch.columns[i], batch.rows[i]);
+
+                if (batch.columns[i] == 1)
+                {
+                    xlnt_assert_equals(batch.numbers[i], expected.value<double>());
+                }
+                else
+                {
+                    xlnt_assert_equals(reader.workbook().shared_strings(batch.shared_strings[i]).plain_text(),
+                        expected.value<std::string>());
+                }
+            }
+        }
+
+        xlnt_assert_equals(rows, 2995);
+        xlnt_assert_equals(batch.last_row, 0);
+        xlnt_assert(!reader.read_row(row));
+        xlnt_assert_equals(reader.end_worksheet().row_properties(2).height.get(), 25.0);
+    }
+
     void test_streaming_write()
     {
         const auto path = std::string("stream-out.xlsx");
@@ -712,6 +936,133 @@ public:
         c3.value("C3!");
     }
 
+    void test_streaming_write_failure()
+    {
+        // a stream that rejects everything written to it
+        struct failing_streambuf : std::streambuf
+        {
+        } failing_buffer;
+
+        std::ostream failing(&failing_buffer);
+        failing.exceptions(std::ios::badbit);
+
+        {
+            // the destructor can't report the error but mustn't terminate
+            xlnt::streaming_workbook_writer writer;
+            writer.open(failing);
+        }
+
+        failing.clear();
+        xlnt::streaming_workbook_writer writer;
+        writer.open(failing);
+        xlnt_assert_throws(writer.close(), std::exception);
+        xlnt_assert_throws_nothing(writer.close());
+    }
+
+    void test_streaming_write_rows()
+    {
+        std::vector<std::uint8_t> buffer;
+        {
+            xlnt::streaming_workbook_writer writer;
+            writer.open(buffer);
+
+            auto bold = writer.workbook().create_format().font(xlnt::font().bold(true), true);
+
+            writer.add_worksheet("Data");
+            writer.append_row(bold, "id", "name", "amount", "paid");
+
+            for (int row = 2; row <= 3000; ++row)
+            {
+                writer.append_row(row, std::string("name ") + std::to_string(row % 7), row * 0.5, row % 2 == 0);
+            }
+
+            writer.append_row(nullptr, "skipped A", bold, nullptr, xlnt::date(2020, 2, 29));
+            writer.add_cell("C3003").value("shared");
+            xlnt_assert_throws(writer.add_cell("B3003"), xlnt::invalid_parameter);
+
+            writer.add_worksheet("Second");
+            writer.append_row("only row");
+            writer.add_cell("B5").value(5);
+        }
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        xlnt_assert_equals(loaded.sheet_titles(), std::vector<std::string>({"Data", "Second"}));
+
+        auto data = loaded.sheet_by_title("Data");
+        xlnt_assert_equals(data.cell("A1").value<std::string>(), "id");
+        xlnt_assert(data.cell("D1").font().bold());
+        xlnt_assert_equals(data.cell("A3000").value<int>(), 3000);
+        xlnt_assert_equals(data.cell("B3000").value<std::string>(), "name 4");
+        xlnt_assert_equals(data.cell("B3000").data_type(), xlnt::cell::type::inline_string);
+        xlnt_assert_equals(data.cell("C3000").value<double>(), 1500.0);
+        xlnt_assert(data.cell("D3000").value<bool>());
+        xlnt_assert(!data.cell("A3001").has_value());
+        xlnt_assert_equals(data.cell("B3001").value<std::string>(), "skipped A");
+        xlnt_assert(data.cell("C3001").font().bold());
+        xlnt_assert(!data.cell("C3001").has_value());
+        xlnt_assert(data.cell("D3001").is_date());
+        xlnt_assert_equals(data.cell("D3001").value<xlnt::date>(), xlnt::date(2020, 2, 29));
+        xlnt_assert_equals(data.cell("C3003").value<std::string>(), "shared");
+        xlnt_assert_equals(data.cell("C3003").data_type(), xlnt::cell::type::shared_string);
+        xlnt_assert(!data.has_cell("B3003"));
+
+        auto second = loaded.sheet_by_title("Second");
+        xlnt_assert_equals(second.cell("A1").value<std::string>(), "only row");
+        xlnt_assert_equals(second.cell("B5").value<int>(), 5);
+        xlnt_assert_equals(second.calculate_dimension(), xlnt::range_reference("A1:B5"));
+    }
+
+    void test_streaming_write_spilled_strings()
+    {
+        std::vector<std::uint8_t> buffer;
+        {
+            xlnt::streaming_workbook_writer writer;
+            writer.open(buffer);
+            writer.spill_shared_strings();
+
+            for (int row = 1; row <= 2000; ++row)
+            {
+                writer.append_row("category " + std::to_string(row % 10), "unique " + std::to_string(row), row);
+            }
+
+            writer.add_cell("A2001").value("category 3");
+            writer.add_cell("B2001").value(xlnt::rich_text("bold", xlnt::font().bold(true)));
+            writer.add_cell("C2001").value("only here");
+        }
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        auto ws = loaded.active_sheet();
+
+        xlnt_assert_equals(ws.cell("A1").value<std::string>(), "category 1");
+        xlnt_assert_equals(ws.cell("A1").data_type(), xlnt::cell::type::shared_string);
+        xlnt_assert_equals(ws.cell("B2000").value<std::string>(), "unique 2000");
+        xlnt_assert_equals(ws.cell("C2000").value<int>(), 2000);
+        xlnt_assert_equals(ws.cell("A2001").value<std::string>(), "category 3");
+        xlnt_assert_equals(ws.cell("C2001").value<std::string>(), "only here");
+
+        // ten categories, 2000 unique strings and the one added last
+        xlnt_assert_equals(loaded.shared_strings().size(), 2011);
+
+        // formatted text doesn't go in the table
+        std::string part;
+        {
+            xlnt::detail::vector_istreambuf written_buffer(buffer);
+            std::istream written_stream(&written_buffer);
+            xlnt::detail::izstream archive(written_stream);
+            part = archive.read(xlnt::path("xl/worksheets/sheet1.xml"));
+        }
+        xlnt_assert_differs(part.find("<c r=\"B2001\" t=\"inlineStr\">"), std::string::npos);
+
+        // too late once a string has gone to the table in memory
+        std::vector<std::uint8_t> unused;
+        xlnt::streaming_workbook_writer writer;
+        writer.open(unused);
+        writer.add_cell("A1").value("in memory");
+        xlnt_assert_throws(writer.spill_shared_strings(), xlnt::invalid_parameter);
+    }
+
     void test_load_save_german_locale()
     {
        /* std::locale current(std::locale::global(std::locale("de-DE")));
@@ -736,5 +1087,693 @@ public:
         auto cell = wbr.read_cell();
         xlnt_assert_equals(cell.value<std::string>(), std::string("a"));
     }
+
+    void test_round_trip_sparse_wide_sheet()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        // a handful of cells spanning the whole grid
+        ws.cell("A1").value(1);
+        ws.cell("XFD1").value(2);
+        ws.cell("C18").value("text");
+        ws.cell("B18").value(3);
+        ws.cell("D100000").formula("=A1+1");
+        ws.cell("E5").value(4);
+        ws.cell("E5").clear_value();
+
+        xlnt::row_properties props;
+        props.height = 20;
+        props.custom_height = true;
+        ws.add_row_properties(50, props);
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        auto loaded_ws = loaded.active_sheet();
+
+        xlnt_assert_equals(loaded_ws.calculate_dimension(), xlnt::range_reference("A1:XFD100000"));
+        xlnt_assert_equals(loaded_ws.cell("XFD1").value<int>(), 2);
+        xlnt_assert_equals(loaded_ws.cell("B18").value<int>(), 3);
+        xlnt_assert_equals(loaded_ws.cell("C18").value<std::string>(), "text");
+        xlnt_assert_equals(loaded_ws.cell("D100000").formula(), "A1+1");
+        xlnt_assert(!loaded_ws.has_cell("E5"));
+        xlnt_assert(loaded_ws.has_row_properties(50));
+        xlnt_assert_equals(loaded_ws.row_properties(50).height.get(), 20);
+    }
+
+    void test_load_worksheets_concurrently()
+    {
+        xlnt::load_options parallel;
+        parallel.worksheet_threads = 4;
+
+        for (const auto &file : {"10_comments_hyperlinks_formulae.xlsx", "13_custom_heights_widths.xlsx",
+                 "14_images.xlsx", "4_every_style.xlsx"})
+        {
+            xlnt::workbook sequential_wb;
+            sequential_wb.load(path_helper::test_file(file));
+            xlnt::workbook parallel_wb;
+            parallel_wb.load(path_helper::test_file(file), parallel);
+            xlnt_assert(workbooks_match(sequential_wb, parallel_wb));
+        }
+
+        xlnt::workbook wb;
+
+        for (int sheet = 0; sheet < 12; ++sheet)
+        {
+            auto ws = sheet == 0 ? wb.active_sheet() : wb.create_sheet();
+            ws.title("Sheet " + std::to_string(sheet));
+
+            for (xlnt::row_t row = 1; row <= 200; ++row)
+            {
+                ws.cell(1, row).value(static_cast<int>(row) * sheet);
+                ws.cell(2, row).value("text " + std::to_string(row % 17));
+                ws.cell(3, row).formula("=A" + std::to_string(row) + "*2");
+            }
+
+            ws.cell("D1").hyperlink("https://example.com/" + std::to_string(sheet));
+            ws.cell("E1").value("noted");
+            ws.cell("E1").comment(xlnt::comment("note " + std::to_string(sheet), "author"));
+            ws.merge_cells("F1:G2");
+        }
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::workbook sequential_wb;
+        sequential_wb.load(buffer);
+        xlnt::workbook parallel_wb;
+        parallel_wb.load(buffer, parallel);
+        xlnt_assert(workbooks_match(sequential_wb, parallel_wb));
+
+        for (std::size_t sheet_index = 0; sheet_index < 12; ++sheet_index)
+        {
+            auto ws = parallel_wb.sheet_by_index(sheet_index);
+            xlnt_assert_equals(ws.title(), "Sheet " + std::to_string(sheet_index));
+            xlnt_assert_equals(ws.cell("A200").value<int>(), 200 * static_cast<int>(sheet_index));
+            xlnt_assert_equals(ws.cell("B35").value<std::string>(), "text 1");
+            xlnt_assert_equals(ws.cell("C7").formula(), "A7*2");
+            xlnt_assert_equals(ws.cell("E1").comment().plain_text(), "note " + std::to_string(sheet_index));
+        }
+
+        xlnt_assert_equals(parallel_wb.sheet_count(), 12);
+    }
+    void test_load_sheet_data_in_batches()
+    {
+        // enough cells for sheetData to be parsed and built on separate threads
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+        auto bold = wb.create_format().font(xlnt::font().bold(true), true);
+
+        for (xlnt::row_t row = 1; row <= 5000; ++row)
+        {
+            ws.cell(1, row).value(static_cast<int>(row));
+            ws.cell(2, row).value("row " + std::to_string(row));
+            ws.cell(3, row).formula("=A" + std::to_string(row) + "+1");
+            ws.row_properties(row).height = 10.0 + row % 7;
+        }
+
+        ws.cell("B4321").format(bold);
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        auto loaded_ws = loaded.active_sheet();
+
+        xlnt_assert_equals(loaded_ws.highest_row(), 5000);
+
+        for (xlnt::row_t row = 1; row <= 5000; ++row)
+        {
+            xlnt_assert_equals(loaded_ws.cell(1, row).value<int>(), static_cast<int>(row));
+            xlnt_assert_equals(loaded_ws.cell(2, row).value<std::string>(), "row " + std::to_string(row));
+            xlnt_assert_equals(loaded_ws.cell(3, row).formula(), "A" + std::to_string(row) + "+1");
+            xlnt_assert_equals(loaded_ws.row_properties(row).height.get(), 10.0 + row % 7);
+        }
+
+        xlnt_assert(loaded_ws.cell("B4321").font().bold());
+        xlnt_assert(!loaded_ws.cell("B4322").has_format());
+
+        // the same batches, scanned and built in turn on this thread
+        xlnt::load_options single_threaded;
+        single_threaded.pipeline_worksheets = false;
+        xlnt::workbook unpipelined;
+        unpipelined.load(buffer, single_threaded);
+        xlnt_assert(workbooks_match(loaded, unpipelined));
+    }
+    void test_load_row_larger_than_batch()
+    {
+        // rows several times the size of a batch, read in ever larger pieces
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        for (xlnt::column_t::index_t column = 1; column <= 16384; ++column)
+        {
+            for (xlnt::row_t row = 2; row <= 3; ++row)
+            {
+                ws.cell(column, row).value("cell " + std::to_string(column * row));
+            }
+        }
+
+        ws.cell("A1").value(1);
+        ws.cell("A4").value(4);
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        auto loaded_ws = loaded.active_sheet();
+
+        xlnt_assert(workbooks_match(wb, loaded));
+        xlnt_assert_equals(loaded_ws.cell("XFD3").value<std::string>(), "cell " + std::to_string(16384 * 3));
+        xlnt_assert_equals(loaded_ws.cell("A4").value<int>(), 4);
+    }
+
+    void test_load_hand_written_sheet_data()
+    {
+        xlnt::workbook wb;
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        const auto sheet_path = xlnt::path("xl/worksheets/sheet1.xml");
+        const auto start = std::string("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+            "<x:worksheet xmlns:x=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+            "<x:dimension ref=\"A1:D4\"/>");
+        const auto end = std::string("<x:mergeCells count=\"1\"><x:mergeCell ref=\"A10:B10\"/></x:mergeCells>"
+            "</x:worksheet>");
+
+        // prefixed names, references, CDATA, comments, omitted r attributes and empty rows
+        const auto sheet_data = std::string("<x:sheetData>\r\n  <!-- <row r=\"2\"> -->\r\n"
+            "<x:row r=\"1\" spans=\"1:4\">"
+            "<x:c r=\"A1\" t=\"inlineStr\"><x:is><x:t>a &amp; b &lt;&#x3A9;&#937;&gt;</x:t></x:is></x:c>"
+            "<x:c t=\"str\"><x:f>\"x\"&amp;\"y\"</x:f><x:v>xy</x:v></x:c>"
+            "<x:c><x:v>2.5</x:v></x:c>"
+            "<x:c t=\"inlineStr\"><x:is><x:t xml:space=\"preserve\">one\r\ntwo</x:t></x:is></x:c>"
+            "</x:row>\r\n"
+            "<x:row r=\"3\" ht=\"30\" customHeight=\"1\"/>"
+            "<x:row><x:c r=\"B4\" t=\"inlineStr\"><x:is><x:t><![CDATA[<raw> & text]]></x:t></x:is></x:c>"
+            "<x:c r=\"C4\" t=\"b\"><x:v>1</x:v></x:c><x:extLst><x:ext><x:c r=\"Z4\"/></x:ext></x:extLst></x:row>"
+            "</x:sheetData>");
+
+        xlnt::workbook loaded;
+        loaded.load(replace_part(buffer, sheet_path, start + sheet_data + end));
+        auto ws = loaded.active_sheet();
+
+        xlnt_assert_equals(ws.cell("A1").value<std::string>(), "a & b <\xCE\xA9\xCE\xA9>");
+        xlnt_assert_equals(ws.cell("B1").formula(), "\"x\"&\"y\"");
+        xlnt_assert_equals(ws.cell("B1").value<std::string>(), "xy");
+        xlnt_assert_equals(ws.cell("C1").value<double>(), 2.5);
+        xlnt_assert_equals(ws.cell("D1").value<std::string>(), "one\ntwo");
+        xlnt_assert(!ws.has_cell("A2"));
+        xlnt_assert_equals(ws.row_properties(3).height.get(), 30.0);
+        xlnt_assert(ws.row_properties(3).custom_height);
+        xlnt_assert_equals(ws.cell("B4").value<std::string>(), "<raw> & text");
+        xlnt_assert(ws.cell("C4").value<bool>());
+        xlnt_assert(!ws.has_cell("Z4"));
+        xlnt_assert_equals(ws.merged_ranges().size(), 1);
+
+        loaded.load(replace_part(buffer, sheet_path, start + "<x:sheetData/>" + end));
+        xlnt_assert_equals(loaded.active_sheet().merged_ranges().size(), 1);
+        xlnt_assert(!loaded.active_sheet().has_cell("A1"));
+
+        xlnt_assert_throws(loaded.load(replace_part(buffer, sheet_path, start + "<x:sheetData><x:row r=\"1\"><x:c r=\"A1\"><x:v>1")),
+            xlnt::exception);
+    }
+
+    void test_round_trip_shared_formulae()
+    {
+        xlnt::workbook wb;
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        const auto sheet_path = xlnt::path("xl/worksheets/sheet1.xml");
+        const auto sheet = std::string("<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>"
+            "<row r=\"1\"><c r=\"A1\"><v>1</v></c><c r=\"B1\"><f t=\"shared\" ref=\"B1:C3\" si=\"4\">A1*$A$1+SUM(A$1:A1)</f><v>2</v></c>"
+            "<c r=\"C1\"><f t=\"shared\" si=\"4\"/><v>3</v></c></row>"
+            "<row r=\"2\"><c r=\"A2\"><v>2</v></c><c r=\"B2\"><f t=\"shared\" si=\"4\"/><v>4</v></c>"
+            "<c r=\"C2\"><f t=\"shared\" si=\"4\"/><v>5</v></c></row>"
+            "<row r=\"3\"><c r=\"B3\"><f t=\"shared\" si=\"4\"/><v>6</v></c><c r=\"C3\"><f>A1</f><v>1</v></c></row>"
+            "</sheetData></worksheet>");
+        const auto with_shared = replace_part(buffer, sheet_path, sheet);
+
+        xlnt::workbook loaded;
+        loaded.load(with_shared);
+        auto ws = loaded.active_sheet();
+
+        xlnt_assert_equals(ws.cell("B1").formula(), "A1*$A$1+SUM(A$1:A1)");
+        xlnt_assert_equals(ws.cell("C1").formula(), "B1*$A$1+SUM(B$1:B1)");
+        xlnt_assert_equals(ws.cell("B3").formula(), "A3*$A$1+SUM(A$1:A3)");
+        xlnt_assert_equals(ws.cell("C3").formula(), "A1");
+        xlnt_assert_equals(ws.cell("C2").value<int>(), 5);
+
+        // a cell given a formula of its own leaves the group
+        ws.cell("C2").formula("=1+1");
+        xlnt_assert_equals(ws.cell("C2").formula(), "1+1");
+        xlnt_assert_equals(ws.cell("B2").formula(), "A2*$A$1+SUM(A$1:A2)");
+
+        // saving keeps one copy of the formula text for the group
+        std::vector<std::uint8_t> resaved;
+        loaded.save(resaved);
+        std::string part;
+        {
+            xlnt::detail::vector_istreambuf resaved_buffer(resaved);
+            std::istream resaved_stream(&resaved_buffer);
+            xlnt::detail::izstream archive(resaved_stream);
+            part = archive.read(sheet_path);
+        }
+        xlnt_assert_differs(part.find("<f t=\"shared\" ref=\"B1:C3\" si=\"0\">A1*$A$1+SUM(A$1:A1)</f>"), std::string::npos);
+        xlnt_assert_equals(part.find("B1*$A$1"), std::string::npos);
+
+        xlnt::workbook reloaded;
+        reloaded.load(resaved);
+        xlnt_assert(workbooks_match(reloaded, loaded));
+        xlnt_assert_equals(reloaded.active_sheet().cell("C1").formula(), "B1*$A$1+SUM(B$1:B1)");
+
+        // without the cell holding the text, the group is anchored at the next one
+        // and the cells left of that get formulas of their own
+        reloaded.active_sheet().clear_cell("B1");
+        reloaded.save(resaved);
+        {
+            xlnt::detail::vector_istreambuf resaved_buffer(resaved);
+            std::istream resaved_stream(&resaved_buffer);
+            xlnt::detail::izstream archive(resaved_stream);
+            part = archive.read(sheet_path);
+        }
+        xlnt_assert_differs(part.find("<f t=\"shared\" ref=\"C1:C1\" si=\"0\">B1*$A$1+SUM(B$1:B1)</f>"), std::string::npos);
+        xlnt_assert_differs(part.find("<f>A2*$A$1+SUM(A$1:A2)</f>"), std::string::npos);
+        xlnt::workbook without_master;
+        without_master.load(resaved);
+        xlnt_assert_equals(without_master.active_sheet().cell("C1").formula(), "B1*$A$1+SUM(B$1:B1)");
+        xlnt_assert_equals(without_master.active_sheet().cell("B3").formula(), "A3*$A$1+SUM(A$1:A3)");
+        xlnt_assert(!without_master.active_sheet().has_cell("B1"));
+
+        // a window that leaves out the cell holding the text keeps the formulas of the rest
+        xlnt::load_options window;
+        window.first_row = 2;
+        window.first_column = xlnt::column_t("C");
+        xlnt::workbook windowed;
+        windowed.load(with_shared, window);
+        xlnt_assert(!windowed.active_sheet().has_cell("B1"));
+        xlnt_assert(!windowed.active_sheet().has_cell("B2"));
+        xlnt_assert_equals(windowed.active_sheet().cell("C2").formula(), "B2*$A$1+SUM(B$1:B2)");
+        xlnt_assert_equals(windowed.active_sheet().cell("C3").formula(), "A1");
+        windowed.save(resaved);
+        xlnt::workbook windowed_reloaded;
+        windowed_reloaded.load(resaved);
+        xlnt_assert_equals(windowed_reloaded.active_sheet().cell("C2").formula(), "B2*$A$1+SUM(B$1:B2)");
+
+        // moved cells keep their formula text, as other formulae do
+        ws.insert_columns(2, 1);
+        xlnt_assert_equals(ws.cell("C1").formula(), "A1*$A$1+SUM(A$1:A1)");
+        xlnt_assert_equals(ws.cell("D3").formula(), "A1");
+
+        // streaming sees every formula of the group
+        xlnt::streaming_workbook_reader reader;
+        reader.open(with_shared);
+        reader.begin_worksheet("Sheet1");
+        auto formulae = std::vector<std::string>();
+
+        while (reader.has_cell())
+        {
+            auto cell = reader.read_cell();
+
+            if (cell.has_formula())
+            {
+                formulae.push_back(cell.reference().to_string() + "=" + cell.formula());
+            }
+        }
+
+        reader.end_worksheet();
+        xlnt_assert_equals(formulae.size(), 6);
+        xlnt_assert_equals(formulae[1], "C1=B1*$A$1+SUM(B$1:B1)");
+        xlnt_assert_equals(formulae[4], "B3=A3*$A$1+SUM(A$1:A3)");
+    }
+
+    void test_load_selected_parts()
+    {
+        xlnt::workbook wb;
+        auto bold = wb.create_format().font(xlnt::font().bold(true), true);
+
+        for (int sheet = 0; sheet < 4; ++sheet)
+        {
+            auto ws = sheet == 0 ? wb.active_sheet() : wb.create_sheet();
+            ws.title("Sheet " + std::to_string(sheet));
+            ws.cell("A1").value(sheet);
+            ws.cell("A2").formula("=A1*2");
+            ws.cell("A2").value(sheet * 2);
+            ws.cell("B1").value("text");
+            ws.cell("B1").format(bold);
+            ws.cell("B1").comment(xlnt::comment("note", "author"));
+            ws.cell("C1").hyperlink("https://example.com/" + std::to_string(sheet));
+        }
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::load_options values_only;
+        values_only.sheet_titles = {"Sheet 2"};
+        values_only.sheet_indices = {0};
+        values_only.skip_styles = true;
+        values_only.skip_comments = true;
+        values_only.skip_formulas = true;
+
+        xlnt::workbook loaded;
+        loaded.load(buffer, values_only);
+
+        xlnt_assert_equals(loaded.sheet_count(), 2);
+        xlnt_assert_equals(loaded.sheet_titles(), std::vector<std::string>({"Sheet 0", "Sheet 2"}));
+
+        for (auto index : {0, 2})
+        {
+            auto ws = loaded.sheet_by_title("Sheet " + std::to_string(index));
+            xlnt_assert_equals(ws.cell("A1").value<int>(), index);
+            xlnt_assert_equals(ws.cell("A2").value<int>(), index * 2);
+            xlnt_assert(!ws.cell("A2").has_formula());
+            xlnt_assert_equals(ws.cell("B1").value<std::string>(), "text");
+            xlnt_assert(!ws.cell("B1").has_format());
+            xlnt_assert(!ws.cell("B1").has_comment());
+            xlnt_assert_equals(ws.cell("C1").hyperlink().url(), "https://example.com/" + std::to_string(index));
+        }
+
+        // what is left can still be formatted and saved
+        loaded.sheet_by_index(1).cell("D1").format(loaded.create_format().font(xlnt::font().italic(true), true));
+        std::vector<std::uint8_t> resaved;
+        loaded.save(resaved);
+        xlnt::workbook reloaded;
+        reloaded.load(resaved);
+        xlnt_assert_equals(reloaded.sheet_titles(), loaded.sheet_titles());
+        xlnt_assert(reloaded.sheet_by_index(1).cell("D1").font().italic());
+        xlnt_assert_equals(reloaded.sheet_by_index(1).cell("A1").value<int>(), 2);
+        xlnt_assert_equals(reloaded.sheet_by_index(1).cell("C1").hyperlink().url(), "https://example.com/2");
+        xlnt_assert(!reloaded.sheet_by_index(1).cell("B1").has_comment());
+
+        xlnt::load_options sheets_only;
+        sheets_only.sheet_indices = {3};
+        std::istringstream stream(std::string(buffer.begin(), buffer.end()));
+        xlnt::workbook constructed(stream, sheets_only);
+        xlnt_assert_equals(constructed.sheet_titles(), std::vector<std::string>({"Sheet 3"}));
+        xlnt_assert_equals(constructed.active_sheet().cell("A2").formula(), "A1*2");
+        xlnt_assert(constructed.active_sheet().cell("B1").font().bold());
+        xlnt_assert_equals(constructed.active_sheet().cell("B1").comment().plain_text(), "note");
+
+        xlnt::load_options no_drawings;
+        no_drawings.skip_drawings = true;
+        xlnt::workbook images(path_helper::test_file("14_images.xlsx"), no_drawings);
+        xlnt_assert(!images.active_sheet().has_drawing());
+        images.save(resaved);
+        reloaded.load(resaved);
+        xlnt_assert(!reloaded.active_sheet().has_drawing());
+        xlnt::workbook with_images(path_helper::test_file("14_images.xlsx"));
+        xlnt_assert(with_images.active_sheet().has_drawing());
+
+        xlnt::load_options missing;
+        missing.sheet_titles = {"Sheet 9"};
+        xlnt_assert_throws(loaded.load(buffer, missing), xlnt::key_not_found);
+        missing.sheet_titles.clear();
+        missing.sheet_indices = {4};
+        xlnt_assert_throws(loaded.load(buffer, missing), xlnt::key_not_found);
+    }
+
+    void test_load_selected_sheets_active_tab()
+    {
+        xlnt::workbook wb;
+        wb.active_sheet().title("A");
+        wb.create_sheet().title("B");
+        wb.create_sheet().title("C");
+
+        // so that every sheet records whether it's selected
+        for (auto title : {"B", "C"})
+        {
+            wb.sheet_by_title(title).add_view(xlnt::sheet_view());
+        }
+
+        xlnt::load_options selection;
+        selection.sheet_titles = {"B", "C"};
+
+        for (auto lazy : {false, true})
+        {
+            selection.lazy_worksheets = lazy;
+
+            // the active tab follows its sheet or falls back to the first one
+            for (auto active : {std::size_t(0), std::size_t(1), std::size_t(2)})
+            {
+                auto view = wb.view();
+                view.active_tab = active;
+                wb.view(view);
+
+                std::vector<std::uint8_t> buffer;
+                wb.save(buffer);
+
+                xlnt::workbook loaded;
+                loaded.load(buffer, selection);
+                loaded.sheet_by_title("C");
+
+                const auto loaded_active = loaded.view().active_tab;
+                xlnt_assert_equals(loaded_active.is_set() ? loaded_active.get() : 0, active == 0 ? 0 : active - 1);
+
+                // saving the subset selects the same sheet again
+                std::vector<std::uint8_t> subset;
+                loaded.save(subset);
+
+                xlnt::workbook reloaded;
+                reloaded.load(subset);
+                const auto reloaded_active = reloaded.view().active_tab;
+                xlnt_assert_equals(reloaded_active.is_set() ? reloaded_active.get() : 0, active == 0 ? 0 : active - 1);
+            }
+        }
+
+        // reading a deferred sheet leaves the view set after load alone
+        auto view = wb.view();
+        view.active_tab = 0;
+        wb.view(view);
+        wb.sheet_by_title("A").cell("A1").value("a");
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::load_options lazy;
+        lazy.lazy_worksheets = true;
+        xlnt::workbook loaded;
+        loaded.load(buffer, lazy);
+
+        view = loaded.view();
+        view.active_tab = 2;
+        loaded.view(view);
+        xlnt_assert_equals(loaded.sheet_by_index(0).cell("A1").value<std::string>(), "a");
+        xlnt_assert_equals(loaded.view().active_tab.get(), 2);
+    }
+
+    void test_load_cell_window()
+    {
+        // enough rows for the window to end in a later batch than the first
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        for (xlnt::row_t row = 1; row <= 5000; ++row)
+        {
+            for (xlnt::column_t::index_t column = 1; column <= 8; ++column)
+            {
+                ws.cell(column, row).value(static_cast<int>(row * 10 + column));
+            }
+        }
+
+        ws.cell("B3000").comment(xlnt::comment("inside", "author"));
+        ws.cell("A3000").comment(xlnt::comment("outside", "author"));
+        ws.cell("C3001").hyperlink("https://example.com/");
+        ws.merge_cells("B3002:C3003");
+        ws.column_properties("A").width = 20.0;
+        ws.column_properties("C").width = 30.0;
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::load_options window;
+        window.first_row = 2990;
+        window.last_row = 3010;
+        window.first_column = xlnt::column_t("B");
+        window.last_column = xlnt::column_t("D");
+
+        xlnt::workbook loaded;
+        loaded.load(buffer, window);
+        auto loaded_ws = loaded.active_sheet();
+
+        xlnt_assert_equals(loaded_ws.calculate_dimension(), xlnt::range_reference("B2990:D3010"));
+        xlnt_assert_equals(loaded_ws.cell("C3005").value<int>(), 30053);
+        xlnt_assert(!loaded_ws.has_cell("A3000"));
+        xlnt_assert(!loaded_ws.has_cell("E3000"));
+        xlnt_assert(!loaded_ws.has_row_properties(2989));
+        xlnt_assert(!loaded_ws.has_row_properties(3011));
+        xlnt_assert(!loaded_ws.has_column_properties("A"));
+        xlnt_assert(loaded_ws.has_column_properties("C"));
+        xlnt_assert_equals(loaded_ws.cell("B3000").comment().plain_text(), "inside");
+        xlnt_assert(!loaded_ws.cell("C3000").has_comment());
+
+        // the window ended before the last row, so what follows sheetData isn't read
+        xlnt_assert(!loaded_ws.cell("C3001").has_hyperlink());
+        xlnt_assert(loaded_ws.merged_ranges().empty());
+
+        // a window that reaches the end of sheetData reads the rest of the part
+        window.last_row.clear();
+        loaded.load(buffer, window);
+        loaded_ws = loaded.active_sheet();
+        xlnt_assert_equals(loaded_ws.calculate_dimension(), xlnt::range_reference("B2990:D5000"));
+        xlnt_assert(loaded_ws.cell("C3001").has_hyperlink());
+        xlnt_assert_equals(loaded_ws.merged_ranges().size(), 1);
+
+        // nothing past the window is read at all
+        xlnt::workbook small;
+        std::vector<std::uint8_t> small_buffer;
+        small.save(small_buffer);
+
+        const auto sheet = std::string("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+            "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>"
+            "<row r=\"1\"><c r=\"A1\"><v>1</v></c></row>"
+            "<row r=\"2\"><c r=\"A2\"><v>2</v></c></row>"
+            "<row r=\"3\"><c r=\"A3\"><v>3");
+        const auto truncated = replace_part(small_buffer, xlnt::path("xl/worksheets/sheet1.xml"), sheet);
+
+        xlnt::load_options first_rows;
+        first_rows.last_row = 2;
+        loaded.load(truncated, first_rows);
+        xlnt_assert_equals(loaded.active_sheet().cell("A2").value<int>(), 2);
+        xlnt_assert(!loaded.active_sheet().has_cell("A3"));
+        xlnt_assert_throws(loaded.load(truncated), xlnt::exception);
+    }
+
+    void test_load_worksheets_lazily()
+    {
+        xlnt::workbook wb;
+
+        for (int sheet = 0; sheet < 4; ++sheet)
+        {
+            auto ws = sheet == 0 ? wb.active_sheet() : wb.create_sheet();
+            ws.title("Sheet " + std::to_string(sheet));
+
+            for (xlnt::row_t row = 1; row <= 100; ++row)
+            {
+                ws.cell(1, row).value(static_cast<int>(row) * sheet);
+                ws.cell(2, row).value("text " + std::to_string(row));
+            }
+
+            ws.cell("C1").value("noted");
+            ws.cell("C1").comment(xlnt::comment("note " + std::to_string(sheet), "author"));
+        }
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        xlnt::load_options lazy;
+        lazy.lazy_worksheets = true;
+
+        // a broken worksheet only matters once it is asked for
+        const auto broken = replace_part(buffer, xlnt::path("xl/worksheets/sheet3.xml"),
+            "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+            "<sheetData><row r=\"1\"><c r=\"A1\"><v>1");
+        xlnt::workbook partial;
+        {
+            std::istringstream stream(std::string(broken.begin(), broken.end()));
+            partial.load(stream, lazy);
+        }
+        xlnt_assert_equals(partial.sheet_titles(), wb.sheet_titles());
+        xlnt_assert_equals(partial.sheet_by_title("Sheet 1").cell("A100").value<int>(), 100);
+        xlnt_assert_equals(partial.sheet_by_index(3).cell("C1").comment().plain_text(), "note 3");
+        xlnt_assert_throws(partial.sheet_by_index(2), xlnt::exception);
+        // and keeps failing rather than handing out what was read of it
+        xlnt_assert_throws(partial.sheet_by_title("Sheet 2"), xlnt::exception);
+        xlnt_assert_equals(partial.sheet_count(), 4);
+
+        // worksheets still to be read survive moves and copies of the workbook
+        xlnt::workbook loaded;
+        loaded.load(buffer, lazy);
+        buffer.assign(buffer.size(), 0);
+        xlnt::workbook moved(std::move(loaded));
+        xlnt_assert_equals(moved.sheet_by_index(1).cell("B50").value<std::string>(), "text 50");
+        xlnt::workbook copied(moved);
+        xlnt_assert_equals(copied.sheet_by_index(2).cell("A50").value<int>(), 100);
+        xlnt_assert_equals(copied.sheet_by_index(2).workbook().sheet_count(), 4);
+
+        // saving reads whatever is left
+        xlnt_assert(workbooks_match(moved, wb));
+        std::vector<std::uint8_t> resaved;
+        moved.save(resaved);
+        xlnt::workbook reloaded;
+        reloaded.load(resaved);
+        xlnt_assert(workbooks_match(reloaded, wb));
+    }
+
+    void test_probe_workbook()
+    {
+        xlnt::workbook wb;
+        auto first = wb.active_sheet();
+        first.title("Data");
+
+        for (xlnt::row_t row = 1; row <= 100; ++row)
+        {
+            first.cell(1, row).value(static_cast<int>(row));
+            first.cell(3, row).value("text");
+        }
+
+        auto hidden = wb.create_sheet();
+        hidden.title("Lookup");
+        hidden.cell("B2").value(1);
+        hidden.cell("D5").value(2);
+        xlnt::page_setup hidden_setup;
+        hidden_setup.sheet_state(xlnt::sheet_state::hidden);
+        hidden.page_setup(hidden_setup);
+        wb.create_sheet().title("Empty");
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+
+        // cells are never parsed, so a worksheet that is broken after its
+        // dimension doesn't get in the way
+        const auto broken = replace_part(buffer, xlnt::path("xl/worksheets/sheet1.xml"),
+            "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+            "<dimension ref=\"A1:C100\"/><sheetData><row r=\"1\"><c r=\"A1\"><v>1");
+        const xlnt::workbook_probe probe(broken);
+
+        xlnt_assert_equals(probe.sheet_titles(), wb.sheet_titles());
+        const auto &sheets = probe.sheets();
+        xlnt_assert_equals(sheets.size(), 3);
+
+        xlnt_assert_equals(sheets[0].id, 1);
+        xlnt_assert_equals(sheets[0].state, xlnt::sheet_state::visible);
+        xlnt_assert_equals(sheets[0].dimension.get(), xlnt::range_reference("A1:C100"));
+        xlnt_assert_equals(sheets[0].row_count.get(), 100);
+
+        xlnt_assert_equals(sheets[1].title, "Lookup");
+        xlnt_assert_equals(sheets[1].id, 2);
+        xlnt_assert_equals(sheets[1].state, xlnt::sheet_state::hidden);
+        xlnt_assert_equals(sheets[1].dimension.get(), xlnt::range_reference("B2:D5"));
+        xlnt_assert_equals(sheets[1].row_count.get(), 5);
+
+        xlnt_assert_equals(sheets[2].dimension.get(), xlnt::range_reference("A1"));
+
+        // files written by Excel
+        const xlnt::workbook_probe excel(path_helper::test_file("10_comments_hyperlinks_formulae.xlsx"));
+        xlnt::workbook loaded;
+        loaded.load(path_helper::test_file("10_comments_hyperlinks_formulae.xlsx"));
+        xlnt_assert_equals(excel.sheet_titles(), loaded.sheet_titles());
+        xlnt_assert_equals(excel.sheets().front().dimension.get(), loaded.sheet_by_index(0).calculate_dimension());
+
+        // templates have a content type of their own and are found like workbooks
+        std::string content_types;
+        {
+            xlnt::detail::vector_istreambuf source_buffer(buffer);
+            std::istream source_stream(&source_buffer);
+            content_types = xlnt::detail::izstream(source_stream).read(xlnt::path("[Content_Types].xml"));
+        }
+        const auto sheet_type = std::string("spreadsheetml.sheet.main+xml");
+        content_types.replace(content_types.find(sheet_type), sheet_type.size(), "spreadsheetml.template.main+xml");
+        const auto template_data = replace_part(buffer, xlnt::path("[Content_Types].xml"), content_types);
+        xlnt::workbook template_wb;
+        template_wb.load(template_data);
+        xlnt_assert_equals(xlnt::workbook_probe(template_data).sheet_titles(), template_wb.sheet_titles());
+
+        xlnt_assert_throws(xlnt::workbook_probe(path_helper::test_file("does_not_exist.xlsx")), xlnt::exception);
+    }
 };
 static serialization_test_suite x;
@@ -68,6 +68,10 @@ public:
         register_test(test_load_file);
         register_test(test_Issue279);
         register_test(test_Issue353);
+        register_test(test_format_by_index);
+        register_test(test_format_deduplication);
+        register_test(test_compact_styles);
+        register_test(test_shared_strings);
     }
 
     void test_active_sheet()
@@ -509,5 +513,168 @@ public:
         xlnt_assert_equals(ws.row_properties(1).spans.get(), "1:8");
         xlnt_assert_equals(ws.row_properties(17).spans.get(), "2:7");
     }
+
+    void test_format_by_index()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        for (int i = 0; i < 50; ++i)
+        {
+            xlnt::font font;
+            font.size(10 + i);
+            ws.cell(xlnt::cell_reference(1, static_cast<xlnt::row_t>(i + 1))).format(wb.create_format().font(font, true));
+        }
+
+        auto font_sizes = [](xlnt::workbook &book) {
+            std::vector<double> sizes;
+
+            for (std::size_t i = 0;; ++i)
+            {
+                try
+                {
+                    auto format = book.format(i);
+                    if (format.font_applied()) sizes.push_back(format.font().size());
+                }
+                catch (const xlnt::invalid_parameter &)
+                {
+                    return sizes;
+                }
+            }
+        };
+
+        // the new formats follow the default one in creation order
+        auto original_sizes = font_sizes(wb);
+        xlnt_assert(original_sizes.size() >= 50);
+        for (std::size_t i = 0; i < 50; ++i)
+        {
+            xlnt_assert_equals(original_sizes[original_sizes.size() - 50 + i], 10 + i);
+        }
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        xlnt_assert(font_sizes(loaded) == original_sizes);
+        xlnt_assert_equals(loaded.active_sheet().cell("A50").font().size(), 59);
+    }
+
+    void test_format_deduplication()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        auto format_count = [&wb]() {
+            std::size_t count = 0;
+
+            try
+            {
+                while (true)
+                {
+                    wb.format(count);
+                    ++count;
+                }
+            }
+            catch (const xlnt::invalid_parameter &)
+            {
+            }
+
+            return count;
+        };
+
+        auto style = [&ws](xlnt::row_t row) {
+            auto cell = ws.cell(xlnt::cell_reference(1, row));
+            cell.font(xlnt::font().size(10 + row % 5));
+            cell.fill(xlnt::fill::solid(row % 3 == 0 ? xlnt::color::red() : xlnt::color::blue()));
+        };
+
+        // every combination of font and fill appears in the first 15 rows
+        for (xlnt::row_t row = 1; row <= 15; ++row)
+        {
+            style(row);
+        }
+
+        const auto count = format_count();
+
+        for (xlnt::row_t row = 16; row <= 300; ++row)
+        {
+            style(row);
+        }
+
+        xlnt_assert_equals(format_count(), count);
+        xlnt_assert_equals(ws.cell("A300").font().size(), 10);
+        xlnt_assert_equals(ws.cell("A300").fill(), xlnt::fill::solid(xlnt::color::red()));
+        xlnt_assert_equals(ws.cell("A299").fill(), xlnt::fill::solid(xlnt::color::blue()));
+    }
+
+    void test_compact_styles()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        auto format_count = [&wb]() {
+            std::size_t count = 0;
+
+            try
+            {
+                while (true)
+                {
+                    wb.format(count);
+                    ++count;
+                }
+            }
+            catch (const xlnt::invalid_parameter &)
+            {
+            }
+
+            return count;
+        };
+
+        for (xlnt::row_t row = 1; row <= 20; ++row)
+        {
+            ws.cell(xlnt::cell_reference(1, row)).font(xlnt::font().size(10 + row));
+        }
+
+        for (xlnt::row_t row = 1; row <= 20; ++row)
+        {
+            ws.cell(xlnt::cell_reference(1, row)).font(xlnt::font().size(50));
+        }
+
+        // the replaced formats are kept until the styles are compacted
+        const auto before = format_count();
+        wb.compact_styles();
+        const auto after = format_count();
+        xlnt_assert(after < before);
+        xlnt_assert_equals(wb.format(after - 1).font().size(), 50);
+        xlnt_assert_equals(ws.cell("A20").font().size(), 50);
+
+        std::vector<std::uint8_t> buffer;
+        wb.save(buffer);
+        xlnt::workbook loaded;
+        loaded.load(buffer);
+        xlnt_assert_equals(loaded.active_sheet().cell("A1").font().size(), 50);
+        xlnt_assert_equals(loaded.active_sheet().cell("A20").font().size(), 50);
+    }
+
+    void test_shared_strings()
+    {
+        xlnt::workbook wb;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            xlnt_assert_equals(wb.add_shared_string(xlnt::rich_text(std::to_string(i))), static_cast<std::size_t>(i));
+        }
+
+        xlnt_assert_equals(wb.add_shared_string(xlnt::rich_text("500")), 500);
+        xlnt_assert_equals(wb.shared_strings().size(), 1000);
+        xlnt_assert_equals(wb.add_shared_string(xlnt::rich_text("500"), true), 1000);
+        xlnt_assert_equals(wb.add_shared_string(xlnt::rich_text("500")), 500);
+
+        xlnt_assert_equals(wb.shared_strings(999).plain_text(), "999");
+        xlnt_assert_equals(wb.shared_strings(1000).plain_text(), "500");
+        xlnt_assert_equals(wb.shared_strings(1001), xlnt::rich_text());
+        xlnt_assert_equals(wb.shared_strings_by_id().size(), 1001);
+        xlnt_assert_equals(wb.shared_strings_by_id()[123].plain_text(), "123");
+    }
 };
 static workbook_test_suite x;
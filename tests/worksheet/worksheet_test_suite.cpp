@@ -22,6 +22,7 @@
 // @author: see AUTHORS file
 
 #include <iostream>
+#include <stdexcept>
 
 #include <xlnt/cell/cell.hpp>
 #include <xlnt/cell/hyperlink.hpp>
@@ -112,6 +113,10 @@ public:
         register_test(test_delete_columns);
         register_test(test_insert_too_many);
         register_test(test_insert_delete_moves_merges);
+        register_test(test_cell_handles_stable);
+        register_test(test_bounds_after_clear);
+        register_test(test_cell_side_table);
+        register_test(test_bounds_follow_edges);
     }
 
     void test_new_worksheet()
@@ -1582,5 +1587,125 @@ public:
             xlnt_assert_equals(merged, expected);
         }
     }
+
+    void test_cell_handles_stable()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        auto first = ws.cell("C3");
+        first.value(42);
+
+        // enough cells in rows on both sides of C3 to need several chunks
+        for (xlnt::row_t row = 1; row <= 100; ++row)
+        {
+            for (xlnt::column_t::index_t column = 1; column <= 20; ++column)
+            {
+                if (row == 3 && column == 3) continue;
+                ws.cell(xlnt::cell_reference(column, row)).value(row * 100 + column);
+            }
+        }
+
+        ws.clear_cell("D3");
+        ws.clear_row(2);
+
+        xlnt_assert_equals(first.value<int>(), 42);
+        xlnt_assert_equals(first.reference(), xlnt::cell_reference("C3"));
+        xlnt_assert(!ws.has_cell("D3"));
+        xlnt_assert(!ws.has_cell("A2"));
+        xlnt_assert_equals(ws.cell("E3").value<int>(), 305);
+        xlnt_assert_equals(ws.cell("T100").value<int>(), 10020);
+
+        const auto &const_ws = ws;
+        xlnt_assert_throws(const_ws.cell("D3"), std::out_of_range);
+    }
+
+    void test_bounds_after_clear()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        ws.cell("E2").value(1);
+        ws.cell("B7").value(2);
+        ws.cell("H4").value(3);
+
+        xlnt_assert_equals(ws.lowest_row(), 2);
+        xlnt_assert_equals(ws.highest_row(), 7);
+        xlnt_assert_equals(ws.lowest_column(), xlnt::column_t("B"));
+        xlnt_assert_equals(ws.highest_column(), xlnt::column_t("H"));
+        xlnt_assert_equals(ws.calculate_dimension(), xlnt::range_reference("B2:H7"));
+
+        ws.clear_cell("B7");
+        ws.clear_row(2);
+
+        xlnt_assert_equals(ws.lowest_row(), 4);
+        xlnt_assert_equals(ws.highest_row(), 4);
+        xlnt_assert_equals(ws.calculate_dimension(), xlnt::range_reference("H4:H4"));
+    }
+
+    void test_cell_side_table()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        ws.cell("A1").formula("=SUM(B1:B2)");
+        ws.cell("A2").error("#REF!");
+        ws.cell("A3").hyperlink("http://example.com");
+        ws.cell("A4").value(4);
+
+        // moving cells keeps their formulae, text and hyperlinks
+        ws.insert_rows(1, 1);
+        xlnt_assert(!ws.cell("A1").has_formula());
+        xlnt_assert_equals(ws.cell("A2").formula(), "SUM(B1:B2)");
+        xlnt_assert_equals(ws.cell("A3").error(), "#REF!");
+        xlnt_assert(ws.cell("A4").has_hyperlink());
+        xlnt_assert_equals(ws.cell("A5").value<int>(), 4);
+
+        // entries of cleared cells are reused rather than leaked
+        ws.clear_cell("A3");
+        ws.cell("C1").formula("=1+1");
+        xlnt_assert_equals(ws.cell("C1").formula(), "1+1");
+        xlnt_assert_equals(ws.cell("A2").formula(), "SUM(B1:B2)");
+
+        ws.cell("A2").clear_formula();
+        xlnt_assert(!ws.cell("A2").has_formula());
+        xlnt_assert_throws(ws.cell("A2").formula(), xlnt::invalid_attribute);
+
+        // copies get their own side table
+        auto copy = wb.copy_sheet(ws);
+        copy.cell("C1").formula("=2+2");
+        xlnt_assert_equals(ws.cell("C1").formula(), "1+1");
+        xlnt_assert_equals(copy.cell("C1").formula(), "2+2");
+        xlnt_assert(copy.cell("A4").has_hyperlink());
+    }
+
+    void test_bounds_follow_edges()
+    {
+        xlnt::workbook wb;
+        auto ws = wb.active_sheet();
+
+        for (xlnt::row_t row = 1; row <= 50; ++row)
+        {
+            ws.cell(xlnt::cell_reference(static_cast<xlnt::column_t::index_t>(row), ws.next_row())).value(row);
+        }
+
+        xlnt_assert_equals(ws.next_row(), 51);
+        xlnt_assert_equals(ws.calculate_dimension(), xlnt::range_reference("A1:AX50"));
+
+        // removing a cell on an edge shrinks the bounds, others leave them alone
+        ws.clear_cell("AX50");
+        xlnt_assert_equals(ws.highest_column(), xlnt::column_t("AW"));
+        ws.clear_cell("J10");
+        xlnt_assert_equals(ws.calculate_dimension(), xlnt::range_reference("A1:AW49"));
+        ws.clear_row(1);
+        xlnt_assert_equals(ws.lowest_column(), xlnt::column_t("B"));
+
+        ws.cell("B2").clear_value();
+        ws.garbage_collect();
+        xlnt_assert_equals(ws.calculate_dimension(), xlnt::range_reference("C3:AW49"));
+
+        ws.insert_columns(1, 2);
+        xlnt_assert_equals(ws.calculate_dimension(), xlnt::range_reference("E3:AY49"));
+    }
 };
 static worksheet_test_suite x;